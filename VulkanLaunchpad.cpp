@@ -10,13 +10,22 @@
 #endif
 
 #include <unordered_map>
+#include <unordered_set>
 #include <map>
 #include <deque>
+#include <list>
 #include <variant>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <functional>
 #define TINYOBJLOADER_IMPLEMENTATION
 #include <tinyobjloader/tiny_obj_loader.h>
 //#define USE_SHADERC
+#ifndef VKL_NO_RUNTIME_SHADER_COMPILATION
 #define USE_GLSLANG
+#endif
 
 // Always use GLI, since the manual implementation of DDS loading does not currently work.
 #define USE_GLI
@@ -26,10 +35,27 @@
 #endif
 #ifdef USE_GLSLANG
 #include <glslang/Include/glslang_c_interface.h>
+#if __has_include(<glslang/build_info.h>)
+#include <glslang/build_info.h>
+#endif
+#endif
+#ifdef VKL_HAS_SPIRV_OPTIMIZER
+#include <spirv-tools/optimizer.hpp>
+#endif
+#ifdef VKL_HAS_PRECOMPILED_BASIC_SHADERS
+#include "vkl_basic.vert.spv.h" // Generated by vkl_add_shaders
+#include "vkl_basic.frag.spv.h" // Generated by vkl_add_shaders
 #endif
 
 #include <fstream>
 #include <iostream>
+#include <filesystem>
+#include <chrono>
+#include <algorithm>
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
@@ -83,29 +109,298 @@ int mFrameInFlightIndex;
 uint32_t mCurrentSwapChainImageIndex;
 
 vk::UniqueCommandPool mCommandPool;
+// A range of device memory which backs a buffer or an image. It has either been sub-allocated from a block of the
+// built-in memory allocator, or it has been allocated on its own (mBlock == nullptr), e.g., for very large resources:
+struct VklMemoryBlock;
+struct VklMemoryAllocation {
+	vk::DeviceMemory mMemory;
+	vk::DeviceSize mOffset = 0;
+	vk::DeviceSize mSize = 0;
+	uint8_t* mMappedData = nullptr; // Points to the start of the range (i.e., at mOffset), if the memory is host-visible
+	VklMemoryBlock* mBlock = nullptr;
+};
 #ifdef VKL_HAS_VMA
-std::unordered_map<VkBuffer, std::variant<vk::UniqueDeviceMemory, VmaAllocation>> mHostCoherentBuffersWithBackingMemory;
-std::unordered_map<VkBuffer, std::variant<vk::UniqueDeviceMemory, VmaAllocation>> mDeviceLocalBuffersWithBackingMemory;
-std::unordered_map<VkImage, std::variant<vk::UniqueDeviceMemory, VmaAllocation>> mImagesWithBackingMemory;
+using VklBackingMemory = std::variant<VklMemoryAllocation, VmaAllocation>;
 #else
-std::unordered_map<VkBuffer, vk::UniqueDeviceMemory> mHostCoherentBuffersWithBackingMemory;
-std::unordered_map<VkBuffer, vk::UniqueDeviceMemory> mDeviceLocalBuffersWithBackingMemory;
-std::unordered_map<VkImage, vk::UniqueDeviceMemory> mImagesWithBackingMemory;
+using VklBackingMemory = VklMemoryAllocation;
 #endif
+std::unordered_map<VkBuffer, VklBackingMemory> mHostCoherentBuffersWithBackingMemory;
+std::unordered_map<VkBuffer, VklBackingMemory> mDeviceLocalBuffersWithBackingMemory;
+std::unordered_map<VkImage, VklBackingMemory> mImagesWithBackingMemory;
 std::deque<vk::UniqueCommandBuffer> mSingleUseCommandBuffers;
+// Command buffers for the compute work of a frame, which are recorded on demand and submitted before the frame's command buffer:
+std::deque<vk::UniqueCommandBuffer> mComputeCommandBuffers;
+bool mComputeCommandBufferRecording = false;
+vk::Pipeline mBoundComputePipeline; // Bound into the current compute command buffer by vklCmdDispatch(Indirect)
+bool mStaticViewportAndScissorBound = false; // Set if binding a pipeline with static viewport and scissor into the current frame's command buffer has invalidated the dynamic ones
+// Uploads into device-local buffers (see vklUploadToDeviceLocalBuffer): Data is staged in a persistently mapped ring buffer,
+// and all copies of a frame are recorded into one command buffer, which is submitted before the frame's compute and rendering work.
+struct VklStagedCopy {
+	vk::Buffer mDstBuffer;
+	vk::BufferCopy mRegion;
+};
+VklStagingConfig mStagingConfig = {};
+VkBuffer mStagingRingBuffer = VK_NULL_HANDLE;
+uint8_t* mStagingRingMappedData = nullptr;
+// Head and tail of the ring are offsets which only ever increase, i.e., the ring is [mStagingRingTail, mStagingRingHead) modulo its size:
+vk::DeviceSize mStagingRingHead = 0;
+vk::DeviceSize mStagingRingTail = 0;
+// The head of the ring after the uploads of the given frame have been submitted, in ascending frame order:
+std::deque<std::tuple<int64_t, vk::DeviceSize>> mStagingRingFrames;
+std::vector<VklStagedCopy> mPendingStagedCopies;
+std::deque<vk::UniqueCommandBuffer> mUploadCommandBuffers;
+// Asynchronous uploads (see vklUploadToDeviceLocalBufferAsync) are submitted to the transfer queue right away, and signal ascending
+// values of a timeline semaphore. Their resources are acquired by the graphics queue in the first frame after they have completed
+// (or in the frame which waits for them), and their staging buffers are destroyed once they have completed and been acquired.
+struct VklAsyncUpload {
+	uint64_t mTimelineValue = 0;
+	VkBuffer mStagingBuffer = VK_NULL_HANDLE;
+	vk::UniqueCommandBuffer mCommandBuffer;
+	std::vector<vk::BufferMemoryBarrier> mBufferAcquireBarriers;
+	std::vector<vk::ImageMemoryBarrier> mImageAcquireBarriers;
+};
+VklTransferQueueConfig mTransferQueueConfig = {};
+vk::UniqueSemaphore mUploadTimelineSemaphore;
+vk::UniqueCommandPool mTransferCommandPool;
+uint64_t mLastUploadTimelineValue = 0;     // Signaled by the last asynchronous upload submitted
+uint64_t mAcquiredUploadTimelineValue = 0; // Asynchronous uploads up to this value have been acquired by a frame
+uint64_t mUploadTimelineValueToWaitFor = 0; // The current frame waits for asynchronous uploads up to this value (see vklWaitForUploadInCurrentFrame)
+bool mUseTimelineSemaphoreKHR = false;      // Set if VK_KHR_timeline_semaphore is enabled, e.g., by applications which target Vulkan 1.1
+std::deque<VklAsyncUpload> mAsyncUploads;   // In ascending timeline value order
+// Transient uniform data (see vklAllocateUniformData) is bump-allocated from one persistently mapped buffer, which has a region
+// of mUniformAllocatorConfig.bytesPerFrame for every frame in flight. A region is reset once its frame's fence has been waited for.
+VklUniformAllocatorConfig mUniformAllocatorConfig = {};
+VkBuffer mUniformBuffer = VK_NULL_HANDLE;
+uint8_t* mUniformBufferMappedData = nullptr;
+vk::DeviceSize mUniformBufferRegionSize = 0;
+vk::DeviceSize mUniformBufferAlignment = 0;
+std::array<vk::DeviceSize, CONCURRENT_FRAMES> mUniformBufferHeads = {};
+
+// A descriptor set layout and a pipeline layout. They are interned, i.e., shared by all pipelines with identical bindings and push constant ranges:
+struct VklPipelineLayouts {
+	vk::UniqueDescriptorSetLayout mDescriptorSetLayout;
+	vk::UniquePipelineLayout mPipelineLayout;
+};
+std::unordered_map<VkPipeline, std::shared_ptr<VklPipelineLayouts>> mPipelineLayouts;
+// The descriptor sets which have last been bound via vklBindDescriptorSetToPipeline, and their layouts, indexed by bind point:
+// [0] for graphics pipelines into the current command buffer, [1] for compute pipelines into the current compute command buffer.
+std::array<vk::DescriptorSet, 2> mBoundDescriptorSets;
+std::array<vk::PipelineLayout, 2> mBoundPipelineLayouts;
+std::array<std::vector<uint32_t>, 2> mBoundDynamicOffsets;
 
-std::unordered_map<VkPipeline, std::tuple<vk::UniqueDescriptorSetLayout, vk::UniquePipelineLayout>> mPipelineLayouts;
-
-vk::Pipeline mBasicPipeline;
+vk::Pipeline mBasicPipeline; // Created lazily in vklGetBasicPipeline
+std::chrono::steady_clock::time_point mInitFrameworkStartTime;
 
 GLFWwindow* mCallbackWindow = nullptr;
 GLFWkeyfun mPreviousKeyCallback = nullptr;
 int mKeyForShaderHotReloading = 0;
 int mModKeysForShaderHotReloading = 0;
-std::unordered_map<VkPipeline, std::tuple<VklGraphicsPipelineConfig, std::string, std::string, bool>> mUserKnownPipelines;
-std::unordered_map<VkPipeline, VkPipeline> mPipelineSurrogates;
+// A file which the code of a shader stage has been read from, i.e., a shader file or a file #included by it.
+// Used to find out which pipelines have to be rebuilt when hot-reloading.
+struct VklShaderFileDependency {
+	std::string mPath;
+	std::filesystem::file_time_type mLastWriteTime;
+	uint64_t mContentHash;
+};
+std::unordered_map<VkPipeline, std::tuple<VklGraphicsPipelineConfig, std::string, std::string, bool, std::vector<VklShaderFileDependency>>> mUserKnownPipelines;
+// The same for compute pipelines: config, compute shader path or code, whether it has been loaded from memory, and its shader files:
+std::unordered_map<VkPipeline, std::tuple<VklComputePipelineConfig, std::string, bool, std::vector<VklShaderFileDependency>>> mUserKnownComputePipelines;
+
+// Returns the files which the shaders of the given known (graphics or compute) pipeline have been compiled from, or nullptr if it is not known.
+std::vector<VklShaderFileDependency>* findKnownPipelineShaderFiles(VkPipeline handle)
+{
+	auto graphics = mUserKnownPipelines.find(handle);
+	if (mUserKnownPipelines.end() != graphics) {
+		return &std::get<4>(graphics->second);
+	}
+	auto compute = mUserKnownComputePipelines.find(handle);
+	if (mUserKnownComputePipelines.end() != compute) {
+		return &std::get<3>(compute->second);
+	}
+	return nullptr;
+}
+// Pipelines which have been replaced (e.g., by hot-reloading), and the frame after which they can be destroyed, in ascending frame order:
 std::deque<std::tuple<int64_t, VkPipeline>> mPipelineGraveyard;
 
+// The handles returned by vklCreateGraphicsPipeline(s) and vklCreateGraphicsPipelineAsync are generational slot handles: They encode an
+// index into mPipelineSlots and the slot's generation, so that they resolve to their current (possibly hot-reloaded) pipeline and layouts
+// without any lookups. They are not valid VkPipelines, i.e., they must always be resolved (see vklCmdBindPipeline).
+struct VklPipelineSlot {
+	VkPipeline mHandle = VK_NULL_HANDLE; // The handle which currently refers to this slot, VK_NULL_HANDLE if the slot is free
+	uint32_t mGeneration = 0; // Incremented whenever the slot is freed, so that stale handles do not resolve to a new pipeline
+	VkPipeline mPipeline = VK_NULL_HANDLE; // The current pipeline, VK_NULL_HANDLE while it is being created asynchronously
+	VkPipeline mFallback = VK_NULL_HANDLE; // Bound while the pipeline is being created (see vklCreateGraphicsPipelineAsync)
+	std::shared_ptr<VklPipelineLayouts> mLayouts;
+	vk::PipelineBindPoint mBindPoint = vk::PipelineBindPoint::eGraphics;
+	bool mStaticViewportAndScissor = false; // Set for graphics pipelines created with VklGraphicsPipelineConfig::dynamicViewportAndScissor = false
+};
+std::vector<VklPipelineSlot> mPipelineSlots;
+std::vector<uint32_t> mFreePipelineSlots;
+// Set in all slot handles. Actual handles are either pointers (which never have the topmost bit set in user space) or small integers:
+constexpr uint64_t PIPELINE_SLOT_HANDLE_TAG = 1ull << 63;
+
+template <typename THandle>
+THandle handleFromAddress(uint64_t address)
+{
+	if constexpr (std::is_pointer_v<THandle>) {
+		return reinterpret_cast<THandle>(static_cast<uintptr_t>(address));
+	}
+	else {
+		return static_cast<THandle>(address);
+	}
+}
+
+template <typename THandle>
+uint64_t addressFromHandle(THandle handle)
+{
+	if constexpr (std::is_pointer_v<THandle>) {
+		return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(handle));
+	}
+	else {
+		return static_cast<uint64_t>(handle);
+	}
+}
+
+// Returns the slot which the given handle refers to, or nullptr if it is not a (live) slot handle.
+VklPipelineSlot* findPipelineSlot(VkPipeline handle)
+{
+	const auto address = addressFromHandle(handle);
+	const auto index = static_cast<size_t>(address & 0xFFFFFFFFull);
+	if (0 == (address & PIPELINE_SLOT_HANDLE_TAG) || index >= mPipelineSlots.size() || mPipelineSlots[index].mHandle != handle) {
+		return nullptr;
+	}
+	return &mPipelineSlots[index];
+}
+
+// Occupies a free slot (or a new one) with the given pipeline, and returns its handle.
+VkPipeline allocatePipelineSlot(vk::PipelineBindPoint bindPoint, VkPipeline pipeline, std::shared_ptr<VklPipelineLayouts> layouts, VkPipeline fallback = VK_NULL_HANDLE)
+{
+	uint32_t index;
+	if (mFreePipelineSlots.empty()) {
+		index = static_cast<uint32_t>(mPipelineSlots.size());
+		mPipelineSlots.emplace_back();
+	}
+	else {
+		index = mFreePipelineSlots.back();
+		mFreePipelineSlots.pop_back();
+	}
+	auto& slot = mPipelineSlots[index];
+	slot.mHandle = handleFromAddress<VkPipeline>(PIPELINE_SLOT_HANDLE_TAG | (static_cast<uint64_t>(slot.mGeneration & 0x7FFFFFFFu) << 32) | index);
+	slot.mPipeline = pipeline;
+	slot.mFallback = fallback;
+	slot.mLayouts = std::move(layouts);
+	slot.mBindPoint = bindPoint;
+	return slot.mHandle;
+}
+
+void freePipelineSlot(VklPipelineSlot& slot)
+{
+	const auto index = static_cast<uint32_t>(addressFromHandle(slot.mHandle) & 0xFFFFFFFFull);
+	slot = VklPipelineSlot{ VK_NULL_HANDLE, slot.mGeneration + 1 };
+	mFreePipelineSlots.push_back(index);
+}
+
+// Returns the current pipeline of slot handles (VK_NULL_HANDLE if it is not ready yet), and all other handles unchanged.
+VkPipeline resolvePipelineHandle(VkPipeline pipeline)
+{
+	const auto* slot = findPipelineSlot(pipeline);
+	return nullptr != slot ? slot->mPipeline : pipeline;
+}
+// Hashes of the SPIR-V of all stages of pipelines built from shader modules, so that hot-reloads which produce identical SPIR-V can keep the pipeline:
+std::unordered_map<VkPipeline, uint64_t> mPipelineSpirvHashes;
+
+// State of the background shader file watcher (see vklEnableShaderFileWatching):
+bool mShaderFileWatchingEnabled = false;
+bool mShaderFileWatchesOutdated = false; // Set whenever the shader files of mUserKnownPipelines or mUserKnownComputePipelines change
+std::chrono::milliseconds mShaderFileWatchingDebounce{ 100 };
+std::unordered_set<std::string> mWatchedShaderFiles; // Normalized paths of all files referenced by known pipelines
+std::unordered_set<std::string> mChangedShaderFiles; // Normalized paths of watched files which have been written, but not reloaded yet
+std::chrono::steady_clock::time_point mLastShaderFileChangeTime;
+#ifdef __linux__
+int mShaderFileWatcherFd = -1;
+std::unordered_map<int, std::string> mWatchedShaderDirectories; // inotify watch descriptors => normalized directory paths
+#endif
+
+// A pool of worker threads, which executes submitted jobs in FIFO order.
+// It is used for compiling shaders and creating pipelines in parallel.
+struct VklWorkerPool {
+	std::vector<std::thread> mThreads;
+	std::deque<std::function<void()>> mJobs;
+	std::mutex mMutex;
+	std::condition_variable mCondition;
+	bool mStopping = false;
+	uint32_t mThreadCount = 0; // 0 => one worker thread per hardware thread
+
+	void workerMain()
+	{
+		for (;;) {
+			std::function<void()> job;
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				mCondition.wait(lock, [this]() { return mStopping || !mJobs.empty(); });
+				if (mJobs.empty()) {
+					return; // => stopping, and all jobs have been processed
+				}
+				job = std::move(mJobs.front());
+				mJobs.pop_front();
+			}
+			job();
+		}
+	}
+
+	// Must be invoked while holding mMutex.
+	void startIfNeeded()
+	{
+		if (!mThreads.empty()) {
+			return;
+		}
+		const auto numThreads = mThreadCount > 0 ? mThreadCount : std::max(1u, std::thread::hardware_concurrency());
+		for (uint32_t i = 0; i < numThreads; ++i) {
+			mThreads.emplace_back([this]() { workerMain(); });
+		}
+	}
+
+	// Processes all remaining jobs, then joins all worker threads.
+	void stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mStopping = true;
+		}
+		mCondition.notify_all();
+		for (auto& thread : mThreads) {
+			thread.join();
+		}
+		mThreads.clear();
+		mStopping = false;
+	}
+
+	~VklWorkerPool()
+	{
+		stop();
+	}
+};
+VklWorkerPool mWorkerPool;
+
+// Executes the given job on one of the worker threads. Returns a future of the job's result.
+template <typename F>
+std::future<std::invoke_result_t<std::decay_t<F>>> submitWorkerJob(F&& job)
+{
+	using R = std::invoke_result_t<std::decay_t<F>>;
+	auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(job));
+	auto future = task->get_future();
+	{
+		std::lock_guard<std::mutex> lock(mWorkerPool.mMutex);
+		mWorkerPool.startIfNeeded();
+		mWorkerPool.mJobs.emplace_back([task]() { (*task)(); });
+	}
+	mWorkerPool.mCondition.notify_one();
+	return future;
+}
+
+// Invoked at frame boundaries and in vklDestroyFramework, defined further below:
+void applyFinishedPipelineReloads(bool waitForAll);
+
 // TODO: Implement this MAKEFOURCC in a sane way instead of just copying definitions.
 enum class byte : unsigned char {};
 #ifndef _BYTE_DEFINED
@@ -361,8 +656,341 @@ glslang_resource_t get_default_resource() {
 }
 #endif
 
-// Compiles a shader to a SPIR-V binary. Returns the binary as a vector of 32-bit words.
-std::vector<uint32_t> compileShaderSourceToSpirv(const std::string& shaderSource, const std::string& inputFilename
+#ifdef USE_GLSLANG
+// Returns the glslang client version and the SPIR-V version for the given Vulkan version, which is expected in
+// VK_API_VERSION_1_x format. Every Vulkan version targets the highest SPIR-V version it requires support for:
+std::tuple<glslang_target_client_version_t, glslang_target_language_version_t> getShaderTargetVersions(uint32_t vulkanVersion)
+{
+	if (vulkanVersion >= VK_API_VERSION_1_3) {
+		return std::make_tuple(GLSLANG_TARGET_VULKAN_1_3, GLSLANG_TARGET_SPV_1_6);
+	}
+	if (vulkanVersion >= VK_API_VERSION_1_2) {
+		return std::make_tuple(GLSLANG_TARGET_VULKAN_1_2, GLSLANG_TARGET_SPV_1_5);
+	}
+	if (vulkanVersion >= VK_API_VERSION_1_1) {
+		return std::make_tuple(GLSLANG_TARGET_VULKAN_1_1, GLSLANG_TARGET_SPV_1_3);
+	}
+	return std::make_tuple(GLSLANG_TARGET_VULKAN_1_0, GLSLANG_TARGET_SPV_1_0);
+}
+#endif
+
+#ifdef VKL_HAS_SPIRV_OPTIMIZER
+spv_target_env getSpirvToolsTargetEnv(uint32_t vulkanVersion)
+{
+	if (vulkanVersion >= VK_API_VERSION_1_3) {
+		return SPV_ENV_VULKAN_1_3;
+	}
+	if (vulkanVersion >= VK_API_VERSION_1_2) {
+		return SPV_ENV_VULKAN_1_2;
+	}
+	if (vulkanVersion >= VK_API_VERSION_1_1) {
+		return SPV_ENV_VULKAN_1_1;
+	}
+	return SPV_ENV_VULKAN_1_0;
+}
+#endif
+
+// Runs SPIRV-Tools' optimization passes for the given optimization level on the SPIR-V code.
+// If optimization fails or is not available, the SPIR-V code is left unchanged.
+void optimizeSpirv(std::vector<uint32_t>& spirv, const VklShaderCompileOptions& options, const std::string& inputFilename)
+{
+	if (VklShaderOptimizationLevel::None == options.optimizationLevel || spirv.empty()) {
+		return;
+	}
+#ifdef VKL_HAS_SPIRV_OPTIMIZER
+	spvtools::Optimizer optimizer(getSpirvToolsTargetEnv(options.targetVulkanVersion));
+	optimizer.SetMessageConsumer([&inputFilename](spv_message_level_t level, const char*, const spv_position_t&, const char* message) {
+		if (level <= SPV_MSG_ERROR) {
+			VKL_WARNING("Optimizing shader[" << inputFilename << "] failed: " << message);
+		}
+	});
+	if (VklShaderOptimizationLevel::Size == options.optimizationLevel) {
+		optimizer.RegisterSizePasses();
+	}
+	else {
+		optimizer.RegisterPerformancePasses();
+	}
+	std::vector<uint32_t> optimizedSpirv;
+	if (optimizer.Run(spirv.data(), spirv.size(), &optimizedSpirv)) {
+		spirv = std::move(optimizedSpirv);
+	}
+#else
+	static std::once_flag warnOnce;
+	std::call_once(warnOnce, []() {
+		VKL_WARNING("Shader optimization has been requested, but Vulkan Launchpad has been built without SPIRV-Tools. Enable the CMake option VKL_ENABLE_SPIRV_OPTIMIZER to optimize shaders.");
+	});
+#endif
+}
+
+// Removes all debug instructions from the SPIR-V code, i.e., source code, names, line information, and the like.
+// (This is the same as SPIRV-Tools' strip-debug pass, but it is implemented here, so that it is always available.)
+void stripSpirvDebugInfo(std::vector<uint32_t>& spirv)
+{
+	constexpr size_t SPIRV_HEADER_WORDS = 5;
+	if (spirv.size() <= SPIRV_HEADER_WORDS) {
+		return;
+	}
+	auto isDebugInstruction = [](uint32_t opcode) {
+		switch (opcode) {
+		case 2:   // OpSourceContinued
+		case 3:   // OpSource
+		case 4:   // OpSourceExtension
+		case 5:   // OpName
+		case 6:   // OpMemberName
+		case 7:   // OpString
+		case 8:   // OpLine
+		case 317: // OpNoLine
+		case 330: // OpModuleProcessed
+			return true;
+		default:
+			return false;
+		}
+	};
+
+	std::vector<uint32_t> stripped(std::begin(spirv), std::begin(spirv) + SPIRV_HEADER_WORDS);
+	stripped.reserve(spirv.size());
+	for (size_t i = SPIRV_HEADER_WORDS; i < spirv.size();) {
+		const uint32_t wordCount = spirv[i] >> 16;
+		const uint32_t opcode = spirv[i] & 0xFFFFu;
+		if (0 == wordCount || i + wordCount > spirv.size()) {
+			return; // => Malformed, leave as it is
+		}
+		if (!isDebugInstruction(opcode)) {
+			stripped.insert(std::end(stripped), std::begin(spirv) + i, std::begin(spirv) + i + wordCount);
+		}
+		i += wordCount;
+	}
+	spirv = std::move(stripped);
+}
+
+// 64-bit FNV-1a hash of the given bytes. Pass the result of a previous call as hash to combine multiple values.
+uint64_t hashBytes(const void* data, size_t size, uint64_t hash = 14695981039346656037ull)
+{
+	const auto* bytes = static_cast<const uint8_t*>(data);
+	for (size_t i = 0; i < size; ++i) {
+		hash ^= static_cast<uint64_t>(bytes[i]);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+uint64_t hashString(const std::string& value, uint64_t hash = 14695981039346656037ull)
+{
+	// Also hash the length so that consecutive strings can not be shifted into each other:
+	const uint64_t length = value.size();
+	return hashBytes(value.data(), value.size(), hashBytes(&length, sizeof(length), hash));
+}
+
+// Reads the whole file at the given path, and records its modification time and content hash. Returns false if it can not be read.
+bool readShaderFile(const std::filesystem::path& path, std::string& out_content, VklShaderFileDependency& out_file)
+{
+	std::error_code ec;
+	// Query the modification time BEFORE reading, so that concurrent modifications are detected at the next hot-reload:
+	const auto lastWriteTime = std::filesystem::last_write_time(path, ec);
+	if (ec) {
+		return false;
+	}
+	std::ifstream file(path, std::ios::binary);
+	if (!file.good()) {
+		return false;
+	}
+	out_content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	out_file.mPath = path.string();
+	out_file.mLastWriteTime = lastWriteTime;
+	out_file.mContentHash = hashString(out_content);
+	return true;
+}
+
+// Returns true if the given file has been modified or deleted since it has been recorded. Files which have only
+// been touched are not considered modified. filesReadDuringThisCheck ensures that every file is read at most once.
+bool hasShaderFileChanged(VklShaderFileDependency& file, std::unordered_map<std::string, VklShaderFileDependency>& filesReadDuringThisCheck)
+{
+	std::error_code ec;
+	const auto lastWriteTime = std::filesystem::last_write_time(file.mPath, ec);
+	if (ec) {
+		return true;
+	}
+	if (lastWriteTime == file.mLastWriteTime) {
+		return false;
+	}
+
+	auto it = filesReadDuringThisCheck.find(file.mPath);
+	if (filesReadDuringThisCheck.end() == it) {
+		std::string content;
+		VklShaderFileDependency current;
+		if (!readShaderFile(file.mPath, content, current)) {
+			return true;
+		}
+		it = filesReadDuringThisCheck.emplace(file.mPath, std::move(current)).first;
+	}
+	if (it->second.mContentHash != file.mContentHash) {
+		return true;
+	}
+	file.mLastWriteTime = it->second.mLastWriteTime; // => Don't compare the contents again next time
+	return false;
+}
+
+// Returns the absolute, lexically normalized form of the given path, so that different spellings of the same file compare equal.
+std::string getNormalizedShaderFilePath(const std::string& path)
+{
+	std::error_code ec;
+	const auto absolute = std::filesystem::absolute(path, ec);
+	return (ec ? std::filesystem::path(path) : absolute).lexically_normal().string();
+}
+
+// Appends those files to the given list, which are not contained in it already.
+void appendShaderFiles(std::vector<VklShaderFileDependency>& files, const std::vector<VklShaderFileDependency>& filesToAppend)
+{
+	for (const auto& file : filesToAppend) {
+		if (std::none_of(std::begin(files), std::end(files), [&file](const VklShaderFileDependency& f) { return f.mPath == file.mPath; })) {
+			files.push_back(file);
+		}
+	}
+}
+
+#ifdef USE_GLSLANG
+// State for resolving the #include directives of one shader via glslang's includer callbacks:
+struct VklShaderIncluder {
+	std::filesystem::path mBaseDirectory; // Directory of the top-level shader file
+	std::unordered_map<std::string, std::filesystem::path> mResolvedPaths; // Names of included files as reported by glslang => resolved paths
+	std::vector<VklShaderFileDependency> mIncludedFiles;
+	std::string mErrors;
+};
+
+// Include result handed out to glslang, which also owns the memory pointed to:
+struct VklShaderIncludeResult : glsl_include_result_t {
+	std::string mName;
+	std::string mData;
+};
+
+// Resolves "..." includes relative to the including file first, and <...> includes as well as
+// all unresolved "..." includes relative to the directory of the top-level shader file.
+glsl_include_result_t* resolveShaderInclude(VklShaderIncluder& includer, const char* headerName, const char* includerName, bool isLocalInclude)
+{
+	std::vector<std::filesystem::path> candidates;
+	if (isLocalInclude && nullptr != includerName) {
+		auto it = includer.mResolvedPaths.find(includerName);
+		if (includer.mResolvedPaths.end() != it) {
+			candidates.push_back(it->second.parent_path() / headerName);
+		}
+	}
+	candidates.push_back(includer.mBaseDirectory / headerName);
+
+	auto* result = new VklShaderIncludeResult{};
+	for (const auto& candidate : candidates) {
+		VklShaderFileDependency file;
+		const auto path = candidate.lexically_normal();
+		if (!readShaderFile(path, result->mData, file)) {
+			continue;
+		}
+		result->mName = file.mPath;
+		includer.mResolvedPaths[headerName] = path;
+		includer.mResolvedPaths[result->mName] = path;
+		appendShaderFiles(includer.mIncludedFiles, { file });
+		break;
+	}
+	if (result->mName.empty()) { // => glslang treats an empty name as failure and reports the data as error message
+		result->mData = "Unable to find included file[" + std::string(headerName) + "]";
+		includer.mErrors += result->mData + "\n";
+	}
+	result->header_name = result->mName.c_str();
+	result->header_data = result->mData.c_str();
+	result->header_length = result->mData.size();
+	return result;
+}
+
+glsl_include_callbacks_t getShaderIncludeCallbacks()
+{
+	glsl_include_callbacks_t callbacks = {};
+	callbacks.include_local = [](void* ctx, const char* header_name, const char* includer_name, size_t include_depth) -> glsl_include_result_t* {
+		return resolveShaderInclude(*static_cast<VklShaderIncluder*>(ctx), header_name, includer_name, true);
+	};
+	callbacks.include_system = [](void* ctx, const char* header_name, const char* includer_name, size_t include_depth) -> glsl_include_result_t* {
+		return resolveShaderInclude(*static_cast<VklShaderIncluder*>(ctx), header_name, includer_name, false);
+	};
+	callbacks.free_include_result = [](void* ctx, glsl_include_result_t* result) -> int {
+		delete static_cast<VklShaderIncludeResult*>(result);
+		return 0;
+	};
+	return callbacks;
+}
+
+// Inserts the given macro definitions into the shader code, right after its #version directive. Also enables the
+// GL_GOOGLE_include_directive extension, which is required for #include, for shaders which don't enable it themselves.
+// The original line numbering is restored afterwards, so that error messages refer to the lines of the original code.
+std::string addDirectivesToShaderSource(const std::string& shaderSource, const std::vector<std::string>& macroDefinitions)
+{
+	std::string directives;
+	if (std::string::npos != shaderSource.find("#include")
+	 && std::string::npos == shaderSource.find("GL_GOOGLE_include_directive")
+	 && std::string::npos == shaderSource.find("GL_ARB_shading_language_include")) {
+		directives += "#extension GL_GOOGLE_include_directive : require\n";
+	}
+	for (const auto& definition : macroDefinitions) {
+		const auto separator = definition.find('=');
+		directives += std::string::npos == separator
+			? "#define " + definition + " 1\n"
+			: "#define " + definition.substr(0, separator) + " " + definition.substr(separator + 1) + "\n";
+	}
+	if (directives.empty()) {
+		return shaderSource;
+	}
+
+	const auto versionPos = shaderSource.find("#version");
+	const auto versionLineEnd = std::string::npos == versionPos ? std::string::npos : shaderSource.find('\n', versionPos);
+	if (std::string::npos == versionLineEnd) {
+		// Without #version, the shader is compiled as version 100, where #line sets the number of the directive's own line:
+		return directives + "#line 0\n" + shaderSource;
+	}
+	const auto nextLineNumber = std::count(std::begin(shaderSource), std::begin(shaderSource) + versionLineEnd + 1, '\n') + 1;
+	return shaderSource.substr(0, versionLineEnd + 1)
+		+ directives
+		+ "#line " + std::to_string(nextLineNumber) + "\n"
+		+ shaderSource.substr(versionLineEnd + 1);
+}
+#endif
+
+VklStartupTimings mStartupTimings = {};
+std::mutex mStartupTimingsMutex; // The shader compiler is initialized on worker threads, all other timings are recorded on the main thread
+bool mFirstFramePresented = false;
+
+double millisecondsSince(std::chrono::steady_clock::time_point t)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t).count();
+}
+
+#ifdef USE_GLSLANG
+std::mutex mGlslangMutex;
+bool mGlslangInitialized = false;
+
+// glslang is initialized lazily, i.e., only when GLSL code actually needs to be compiled.
+// Shaders from the shader cache and precompiled SPIR-V do not require glslang at all.
+void ensureGlslangInitialized()
+{
+	std::lock_guard<std::mutex> lock(mGlslangMutex);
+	if (mGlslangInitialized) {
+		return;
+	}
+	const auto t0 = std::chrono::steady_clock::now();
+	glslang_initialize_process();
+	mGlslangInitialized = true;
+	std::lock_guard<std::mutex> timingsLock(mStartupTimingsMutex);
+	mStartupTimings.shaderCompilerInitializationMilliseconds += millisecondsSince(t0);
+}
+
+void finalizeGlslangIfInitialized()
+{
+	std::lock_guard<std::mutex> lock(mGlslangMutex);
+	if (mGlslangInitialized) {
+		glslang_finalize_process();
+		mGlslangInitialized = false;
+	}
+}
+#endif
+
+// Compiles a shader to a SPIR-V binary, bypassing the shader cache. Returns the binary as a vector of 32-bit words.
+// #include directives are resolved relative to includeBaseDirectory, all files included are returned in out_includedFiles.
+std::vector<uint32_t> compileShaderSourceToSpirvUncached(const std::string& shaderSource, const std::string& inputFilename, const std::string& includeBaseDirectory, const VklShaderCompileOptions& options, std::vector<VklShaderFileDependency>& out_includedFiles
 #ifdef USE_SHADERC
 	, shaderc_shader_kind shaderKind
 #endif
@@ -374,9 +1002,22 @@ std::vector<uint32_t> compileShaderSourceToSpirv(const std::string& shaderSource
 #ifdef USE_SHADERC
 	// This code is borrowed from the shaderc example: https://github.com/google/shaderc/blob/main/examples/online-compile/main.cc
 	shaderc::Compiler compiler;
-	shaderc::CompileOptions options;
+	shaderc::CompileOptions compileOptions; // Note: #include directives are only supported when compiling with glslang
+	for (const auto& definition : options.macroDefinitions) {
+		const auto separator = definition.find('=');
+		if (std::string::npos == separator) {
+			compileOptions.AddMacroDefinition(definition);
+		}
+		else {
+			compileOptions.AddMacroDefinition(definition.substr(0, separator), definition.substr(separator + 1));
+		}
+	}
+	compileOptions.SetTargetEnvironment(shaderc_target_env_vulkan, options.targetVulkanVersion);
+	if (options.generateDebugInfo) {
+		compileOptions.SetGenerateDebugInfo();
+	}
 
-	shaderc::SpvCompilationResult module = compiler.CompileGlslToSpv(shaderSource, shaderKind, inputFilename.c_str(), options);
+	shaderc::SpvCompilationResult module = compiler.CompileGlslToSpv(shaderSource, shaderKind, inputFilename.c_str(), compileOptions);
 
 	if (module.GetCompilationStatus() != shaderc_compilation_status_success) {
 		std::cout << "\nERROR:   Failed to compile shader[" << inputFilename << " of kind[" << to_string(shaderKind) << "]\n"
@@ -385,31 +1026,42 @@ std::vector<uint32_t> compileShaderSourceToSpirv(const std::string& shaderSource
 		throw std::runtime_error("Failed to compile shader " + inputFilename);
 	}
 
-	return { module.cbegin(), module.cend() };
+	std::vector<uint32_t> resultingSpirv(module.cbegin(), module.cend());
+	optimizeSpirv(resultingSpirv, options, inputFilename);
+	if (options.stripDebugInfo) {
+		stripSpirvDebugInfo(resultingSpirv);
+	}
+	return resultingSpirv;
 #else
 	std::vector<uint32_t> resultingSpirv;
 #ifdef USE_GLSLANG
-	const char* shaderCode = shaderSource.c_str();
+	ensureGlslangInitialized();
+
+	const auto shaderSourceWithDirectives = addDirectivesToShaderSource(shaderSource, options.macroDefinitions);
+	const char* shaderCode = shaderSourceWithDirectives.c_str();
+	const auto targetVersions = getShaderTargetVersions(options.targetVulkanVersion);
 
 	static const auto defaultResources = get_default_resource();
+	static const auto includeCallbacks = getShaderIncludeCallbacks();
+	VklShaderIncluder includer;
+	includer.mBaseDirectory = includeBaseDirectory;
 
 	glslang_input_t input = {};
 	input.language = GLSLANG_SOURCE_GLSL;
 	input.stage = shaderStage;
 	input.client = GLSLANG_CLIENT_VULKAN;
-	// Looks like Vulkan 1.1 is fine even though we're linking against a Vulkan 1.2 SDK:
-	input.client_version = GLSLANG_TARGET_VULKAN_1_1;
+	input.client_version = std::get<glslang_target_client_version_t>(targetVersions);
 	input.target_language = GLSLANG_TARGET_SPV;
-	// SPIR-V 1.5 has been released on September 13th, 2019 to accompany the launch of Vulkan 1.2
-	// However, Vulkan 1.1 requires Spir-V 1.3, go with 1.3 to match the Vulkan 1.1 target above:
-	input.target_language_version = GLSLANG_TARGET_SPV_1_3; 
+	input.target_language_version = std::get<glslang_target_language_version_t>(targetVersions);
 	input.code = shaderCode;
 	input.default_version = 100;
 	input.default_profile = GLSLANG_NO_PROFILE;
 	input.force_default_version_and_profile = false;
 	input.forward_compatible = false;
-	input.messages = GLSLANG_MSG_DEFAULT_BIT;
+	input.messages = options.generateDebugInfo ? GLSLANG_MSG_DEBUG_INFO_BIT : GLSLANG_MSG_DEFAULT_BIT;
 	input.resource = &defaultResources;
+	input.callbacks = includeCallbacks;
+	input.callbacks_ctx = &includer;
 	
 	glslang_shader_t* shader = glslang_shader_create(&input);
 
@@ -421,6 +1073,14 @@ std::vector<uint32_t> compileShaderSourceToSpirv(const std::string& shaderSource
 		return resultingSpirv;
 	}
 
+	if (!includer.mErrors.empty())
+	{
+		std::cout << "\nERROR:   Failed to resolve includes of shader[" << inputFilename << "] of kind[" << to_string(shaderStage) << "]"
+			      << "\n         Reason(s)[\n" << includer.mErrors << "         ]" << std::endl;
+		glslang_shader_delete(shader);
+		return resultingSpirv;
+	}
+
 	if (!glslang_shader_parse(shader, &input))
 	{
 		std::cout << "\nERROR:   Failed to parse shader[" << inputFilename << "] of kind[" << to_string(shaderStage) << "]"
@@ -440,7 +1100,17 @@ std::vector<uint32_t> compileShaderSourceToSpirv(const std::string& shaderSource
 		return resultingSpirv;
 	}
 
+#if defined(GLSLANG_VERSION_MAJOR) && GLSLANG_VERSION_MAJOR >= 12
+	glslang_spv_options_t spvOptions = {};
+	spvOptions.generate_debug_info = options.generateDebugInfo;
+	spvOptions.disable_optimizer = true; // Optimization is done by optimizeSpirv
+	glslang_program_SPIRV_generate_with_options(program, input.stage, &spvOptions);
+#else
+	if (options.generateDebugInfo) {
+		VKL_WARNING("Generating debug info for shader[" << inputFilename << "] requires glslang 12 or newer.");
+	}
 	glslang_program_SPIRV_generate(program, input.stage);
+#endif
 
 	if (glslang_program_SPIRV_get_messages(program))
 	{
@@ -452,264 +1122,2117 @@ std::vector<uint32_t> compileShaderSourceToSpirv(const std::string& shaderSource
 	auto* spirvDataPtr = glslang_program_SPIRV_get_ptr(program);
 	const auto spirvNumWords = glslang_program_SPIRV_get_size(program);
 	resultingSpirv.insert(std::end(resultingSpirv), spirvDataPtr, spirvDataPtr + spirvNumWords);
+	out_includedFiles = std::move(includer.mIncludedFiles);
+
+	optimizeSpirv(resultingSpirv, options, inputFilename);
+	if (options.stripDebugInfo) {
+		stripSpirvDebugInfo(resultingSpirv);
+	}
 
 	glslang_program_delete(program);
 	glslang_shader_delete(shader);
 	
+#else
+	std::cout << "\nERROR:   Unable to compile shader[" << inputFilename << "], because Vulkan Launchpad has been built without runtime shader compilation."
+		      << "\n         Use SPIR-V which has been precompiled with vkl_add_shaders instead." << std::endl;
 #endif
 	return resultingSpirv;
 #endif
 }
 
-// Creates a shader module from the given Spir-V code, returns the created shader module and its create info.
-// The entry point is "main" always
-std::tuple<vk::ShaderModule, vk::PipelineShaderStageCreateInfo> loadShaderFromSpirvAndCreateShaderModuleAndStageInfo(const uint32_t* spirv, size_t byteSize, const vk::ShaderStageFlagBits shaderStage)
-{
-	auto moduleCreateInfo = vk::ShaderModuleCreateInfo{}
-		.setCodeSize(byteSize)
-		.setPCode(spirv);
-
-	auto shaderModule = mDevice.createShaderModule(moduleCreateInfo);
-
-	auto shaderStageCreateInfo = vk::PipelineShaderStageCreateInfo{}
-		.setStage(shaderStage)
-		.setModule(shaderModule)
-		.setPName("main"); // entry point
+VklShaderCacheConfig mShaderCacheConfig = {};
+std::string mShaderCacheDirectory = mShaderCacheConfig.cacheDirectory;
+VklShaderCacheStatistics mShaderCacheStatistics = {};
+std::mutex mShaderCacheMutex; // Shaders are compiled on multiple threads concurrently
+
+// Increment whenever the layout of cache entries or the way how shaders are compiled changes:
+constexpr uint32_t SHADER_CACHE_FORMAT_VERSION = 2u;
+constexpr uint32_t SHADER_CACHE_MAGIC = 0x534C4B56u; // "VKLS"
+
+// Precedes the SPIR-V words in every shader cache entry file. The SPIR-V words are followed by numIncludedFiles
+// records of the files which the shader #included, each consisting of <uint64_t content hash, uint64_t path length, path>.
+struct VklShaderCacheEntryHeader {
+	uint32_t magic;
+	uint32_t formatVersion;
+	uint64_t key;
+	uint64_t numWords;
+	uint64_t numIncludedFiles;
+};
 
-	return std::make_tuple(shaderModule, shaderStageCreateInfo);
+// Returns a string which identifies the version of the shader compiler in use:
+std::string getShaderCompilerVersion()
+{
+#if defined(USE_GLSLANG) && defined(GLSLANG_VERSION_MAJOR)
+	return "glslang " + std::to_string(GLSLANG_VERSION_MAJOR) + "." + std::to_string(GLSLANG_VERSION_MINOR) + "." + std::to_string(GLSLANG_VERSION_PATCH);
+#elif defined(USE_GLSLANG)
+	return "glslang";
+#elif defined(USE_SHADERC)
+	return "shaderc";
+#else
+	return "none";
+#endif
 }
 
-std::tuple<vk::ShaderModule, vk::PipelineShaderStageCreateInfo> loadShaderFromMemoryAndCreateShaderModuleAndStageInfo(const std::string& shaderCode, const std::string& shaderName, const vk::ShaderStageFlagBits shaderStage)
+// Hashes all compile options which have an influence on the resulting SPIR-V.
+uint64_t hashShaderCompileOptions(const VklShaderCompileOptions& options, uint64_t key = 14695981039346656037ull)
 {
-#ifdef USE_SHADERC
-	shaderc_shader_kind shadercKind;
-	switch (shaderStage) {
-	case vk::ShaderStageFlagBits::eVertex: shadercKind = shaderc_shader_kind::shaderc_vertex_shader; break;
-	case vk::ShaderStageFlagBits::eTessellationControl: shadercKind = shaderc_shader_kind::shaderc_tess_control_shader; break;
-	case vk::ShaderStageFlagBits::eTessellationEvaluation: shadercKind = shaderc_shader_kind::shaderc_tess_evaluation_shader; break;
-	case vk::ShaderStageFlagBits::eGeometry: shadercKind = shaderc_shader_kind::shaderc_geometry_shader; break;
-	case vk::ShaderStageFlagBits::eFragment: shadercKind = shaderc_shader_kind::shaderc_fragment_shader; break;
-	case vk::ShaderStageFlagBits::eCompute: shadercKind = shaderc_shader_kind::shaderc_compute_shader; break;
-	case vk::ShaderStageFlagBits::eRaygenKHR: shadercKind = shaderc_shader_kind::shaderc_raygen_shader; break;
-	case vk::ShaderStageFlagBits::eAnyHitKHR: shadercKind = shaderc_shader_kind::shaderc_anyhit_shader; break;
-	case vk::ShaderStageFlagBits::eClosestHitKHR: shadercKind = shaderc_shader_kind::shaderc_closesthit_shader; break;
-	case vk::ShaderStageFlagBits::eMissKHR: shadercKind = shaderc_shader_kind::shaderc_miss_shader; break;
-	case vk::ShaderStageFlagBits::eIntersectionKHR: shadercKind = shaderc_shader_kind::shaderc_intersection_shader; break;
-	case vk::ShaderStageFlagBits::eCallableKHR: shadercKind = shaderc_shader_kind::shaderc_callable_shader; break;
-	case vk::ShaderStageFlagBits::eTaskNV: shadercKind = shaderc_shader_kind::shaderc_task_shader; break;
-	case vk::ShaderStageFlagBits::eMeshNV: shadercKind = shaderc_shader_kind::shaderc_mesh_shader; break;
-	}
-	auto spirv = compileShaderSourceToSpirv(shaderCode, shaderName, shadercKind);
-#endif
-#ifdef USE_GLSLANG
-	glslang_stage_t glslangStage;
-	switch (shaderStage) {
-	case vk::ShaderStageFlagBits::eVertex: glslangStage = GLSLANG_STAGE_VERTEX; break;
-	case vk::ShaderStageFlagBits::eTessellationControl: glslangStage = GLSLANG_STAGE_TESSCONTROL; break;
-	case vk::ShaderStageFlagBits::eTessellationEvaluation: glslangStage = GLSLANG_STAGE_TESSEVALUATION; break;
-	case vk::ShaderStageFlagBits::eGeometry: glslangStage = GLSLANG_STAGE_GEOMETRY; break;
-	case vk::ShaderStageFlagBits::eFragment: glslangStage = GLSLANG_STAGE_FRAGMENT; break;
-	case vk::ShaderStageFlagBits::eCompute: glslangStage = GLSLANG_STAGE_COMPUTE; break;
-	case vk::ShaderStageFlagBits::eRaygenKHR: glslangStage = GLSLANG_STAGE_RAYGEN; break;
-	case vk::ShaderStageFlagBits::eAnyHitKHR: glslangStage = GLSLANG_STAGE_ANYHIT; break;
-	case vk::ShaderStageFlagBits::eClosestHitKHR: glslangStage = GLSLANG_STAGE_CLOSESTHIT; break;
-	case vk::ShaderStageFlagBits::eMissKHR: glslangStage = GLSLANG_STAGE_MISS; break;
-	case vk::ShaderStageFlagBits::eIntersectionKHR: glslangStage = GLSLANG_STAGE_INTERSECT; break;
-	case vk::ShaderStageFlagBits::eCallableKHR: glslangStage = GLSLANG_STAGE_CALLABLE; break;
-	case vk::ShaderStageFlagBits::eTaskNV: glslangStage = GLSLANG_STAGE_TASK; break;
-	case vk::ShaderStageFlagBits::eMeshNV: glslangStage = GLSLANG_STAGE_MESH; break;
+	const uint64_t numMacroDefinitions = options.macroDefinitions.size();
+	key = hashBytes(&numMacroDefinitions, sizeof(numMacroDefinitions), key);
+	for (const auto& definition : options.macroDefinitions) {
+		key = hashString(definition, key);
 	}
-	auto spirv = compileShaderSourceToSpirv(shaderCode, shaderName, glslangStage);
+#ifdef VKL_HAS_SPIRV_OPTIMIZER
+	const bool optimizerAvailable = true;
+#else
+	const bool optimizerAvailable = false;
 #endif
-	if (spirv.empty()) {
-		return std::make_tuple(vk::ShaderModule{ VK_NULL_HANDLE }, vk::PipelineShaderStageCreateInfo{});
-	}
-	//                                                        | SPIR-V Code | Size must be specified in BYTE => * sizeof WORD   | Stage      |
-	return loadShaderFromSpirvAndCreateShaderModuleAndStageInfo(spirv.data(), spirv.size() * sizeof(decltype(spirv)::value_type), shaderStage);
+	const int flags[] = { static_cast<int>(options.optimizationLevel), optimizerAvailable ? 1 : 0, options.generateDebugInfo ? 1 : 0, options.stripDebugInfo ? 1 : 0 };
+	key = hashBytes(&options.targetVulkanVersion, sizeof(options.targetVulkanVersion), key);
+	key = hashBytes(flags, sizeof(flags), key);
+	return key;
 }
 
-std::tuple<vk::ShaderModule, vk::PipelineShaderStageCreateInfo> loadShaderFromFileAndCreateShaderModuleAndStageInfo(const std::string& shader_filename, const vk::ShaderStageFlagBits shaderStage)
+// Computes the content-address of a shader, i.e., a hash of everything that has an influence on the resulting SPIR-V.
+// Files included by the shader can not be known before preprocessing it, they are validated when loading an entry.
+uint64_t computeShaderCacheKey(const std::string& shaderSource, const std::string& includeBaseDirectory, const VklShaderCompileOptions& options, int shaderStage)
 {
-    std::string path = {};
+	uint64_t key = hashString(shaderSource);
+	key = hashString(includeBaseDirectory, key);
+	key = hashBytes(&shaderStage, sizeof(shaderStage), key);
+	key = hashShaderCompileOptions(options, key);
+	key = hashString(getShaderCompilerVersion(), key);
+	key = hashBytes(&SHADER_CACHE_FORMAT_VERSION, sizeof(SHADER_CACHE_FORMAT_VERSION), key);
+	return key;
+}
 
-	std::ifstream infile(shader_filename);
-	if (infile.good()) {
-		path = shader_filename;
-		VKL_LOG("Loading shader file from path[" << path << "]...");
-	}
+std::filesystem::path getShaderCacheEntryPath(uint64_t key)
+{
+	char fileName[32];
+	snprintf(fileName, sizeof(fileName), "%016llx.spv", static_cast<unsigned long long>(key));
+	return std::filesystem::path(mShaderCacheDirectory) / fileName;
+}
+
+// Tries to load the SPIR-V for the given key from disk. Returns false if there is no (valid) cache entry,
+// or if any of the files which have been included by the shader have changed since.
+bool tryLoadSpirvFromShaderCache(uint64_t key, std::vector<uint32_t>& out_spirv, std::vector<VklShaderFileDependency>& out_includedFiles)
+{
+	const auto path = getShaderCacheEntryPath(key);
+	std::ifstream file(path, std::ios::binary);
+	if (!file.good()) {
+		return false;
+	}
+
+	VklShaderCacheEntryHeader header = {};
+	file.read(reinterpret_cast<char*>(&header), sizeof(header));
+	if (!file.good() || SHADER_CACHE_MAGIC != header.magic || SHADER_CACHE_FORMAT_VERSION != header.formatVersion || key != header.key || 0 == header.numWords) {
+		return false;
+	}
+
+	out_spirv.resize(static_cast<size_t>(header.numWords));
+	file.read(reinterpret_cast<char*>(out_spirv.data()), static_cast<std::streamsize>(out_spirv.size() * sizeof(uint32_t)));
+	std::vector<VklShaderFileDependency> includedFiles(file.good() ? static_cast<size_t>(header.numIncludedFiles) : 0);
+	for (auto& includedFile : includedFiles) {
+		uint64_t pathLength = 0;
+		file.read(reinterpret_cast<char*>(&includedFile.mContentHash), sizeof(includedFile.mContentHash));
+		file.read(reinterpret_cast<char*>(&pathLength), sizeof(pathLength));
+		if (!file.good() || pathLength > 4096) {
+			break;
+		}
+		includedFile.mPath.resize(static_cast<size_t>(pathLength));
+		file.read(includedFile.mPath.data(), static_cast<std::streamsize>(pathLength));
+	}
+	if (!file.good()) {
+		out_spirv.clear();
+		return false;
+	}
+	file.close();
+
+	// The entry is outdated if any included file has changed:
+	for (auto& includedFile : includedFiles) {
+		std::string content;
+		VklShaderFileDependency current;
+		if (!readShaderFile(includedFile.mPath, content, current) || current.mContentHash != includedFile.mContentHash) {
+			out_spirv.clear();
+			return false;
+		}
+		includedFile.mLastWriteTime = current.mLastWriteTime;
+	}
+	out_includedFiles = std::move(includedFiles);
+
+	// Mark the entry as recently used, so that it is evicted last:
+	std::error_code ec;
+	std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+	return true;
+}
+
+// Deletes the least recently used cache entries until the total size of the cache is within the configured limit.
+void enforceShaderCacheSizeLimit()
+{
+	if (0 == mShaderCacheConfig.maxCacheSizeInBytes) {
+		return;
+	}
+	std::lock_guard<std::mutex> lock(mShaderCacheMutex);
+
+	std::error_code ec;
+	std::vector<std::tuple<std::filesystem::file_time_type, uintmax_t, std::filesystem::path>> entries;
+	uintmax_t totalSize = 0;
+	for (const auto& entry : std::filesystem::directory_iterator(mShaderCacheDirectory, ec)) {
+		if (!entry.is_regular_file(ec) || entry.path().extension() != ".spv") {
+			continue;
+		}
+		const auto size = entry.file_size(ec);
+		entries.emplace_back(entry.last_write_time(ec), size, entry.path());
+		totalSize += size;
+	}
+	if (totalSize <= mShaderCacheConfig.maxCacheSizeInBytes) {
+		return;
+	}
+
+	// Oldest first:
+	std::sort(std::begin(entries), std::end(entries), [](const auto& a, const auto& b) { return std::get<0>(a) < std::get<0>(b); });
+	for (const auto& entry : entries) {
+		if (totalSize <= mShaderCacheConfig.maxCacheSizeInBytes) {
+			break;
+		}
+		if (std::filesystem::remove(std::get<2>(entry), ec)) {
+			totalSize -= std::get<1>(entry);
+			++mShaderCacheStatistics.evictions;
+		}
+	}
+}
+
+void storeSpirvInShaderCache(uint64_t key, const std::vector<uint32_t>& spirv, const std::vector<VklShaderFileDependency>& includedFiles)
+{
+	std::error_code ec;
+	std::filesystem::create_directories(mShaderCacheDirectory, ec);
+	if (ec) {
+		VKL_WARNING("Unable to create the shader cache directory[" << mShaderCacheDirectory << "]: " << ec.message());
+		return;
+	}
+
+	const auto path = getShaderCacheEntryPath(key);
+	// Write to a temporary file first, so that other threads/processes never observe partially written entries:
+	auto tmpPath = path;
+	tmpPath += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+	{
+		std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+		const VklShaderCacheEntryHeader header = { SHADER_CACHE_MAGIC, SHADER_CACHE_FORMAT_VERSION, key, static_cast<uint64_t>(spirv.size()), static_cast<uint64_t>(includedFiles.size()) };
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(spirv.data()), static_cast<std::streamsize>(spirv.size() * sizeof(uint32_t)));
+		for (const auto& includedFile : includedFiles) {
+			const uint64_t pathLength = includedFile.mPath.size();
+			file.write(reinterpret_cast<const char*>(&includedFile.mContentHash), sizeof(includedFile.mContentHash));
+			file.write(reinterpret_cast<const char*>(&pathLength), sizeof(pathLength));
+			file.write(includedFile.mPath.data(), static_cast<std::streamsize>(pathLength));
+		}
+		if (!file.good()) {
+			VKL_WARNING("Unable to write shader cache entry[" << tmpPath.string() << "]");
+			return;
+		}
+	}
+	std::filesystem::rename(tmpPath, path, ec);
+	if (ec) {
+		std::filesystem::remove(tmpPath, ec);
+		return;
+	}
+
+	enforceShaderCacheSizeLimit();
+}
+
+// Compiles a shader to a SPIR-V binary, or loads it from the shader cache if it has been compiled before. Returns the binary as a vector of 32-bit words.
+// #include directives are resolved relative to includeBaseDirectory, all files included are returned in out_includedFiles.
+std::vector<uint32_t> compileShaderSourceToSpirv(const std::string& shaderSource, const std::string& inputFilename, const std::string& includeBaseDirectory, const VklShaderCompileOptions& options, std::vector<VklShaderFileDependency>& out_includedFiles
+#ifdef USE_SHADERC
+	, shaderc_shader_kind shaderKind
+#endif
+#ifdef USE_GLSLANG
+	, glslang_stage_t shaderStage
+#endif
+)
+{
+	const auto uncached = [&]() {
+		return compileShaderSourceToSpirvUncached(shaderSource, inputFilename, includeBaseDirectory, options, out_includedFiles
+#ifdef USE_SHADERC
+			, shaderKind
+#endif
+#ifdef USE_GLSLANG
+			, shaderStage
+#endif
+		);
+	};
+
+#if !defined(USE_SHADERC) && !defined(USE_GLSLANG)
+	// Without a GLSL compiler, nothing is compiled and hence nothing is cached; compileShaderSourceToSpirvUncached reports the error:
+	return uncached();
+#else
+#ifdef USE_SHADERC
+	const int stageForKey = static_cast<int>(shaderKind);
+#endif
+#ifdef USE_GLSLANG
+	const int stageForKey = static_cast<int>(shaderStage);
+#endif
+
+	const auto t0 = std::chrono::steady_clock::now();
+	const auto secondsSince = [](std::chrono::steady_clock::time_point t) { return std::chrono::duration<double>(std::chrono::steady_clock::now() - t).count(); };
+
+	if (!mShaderCacheConfig.enabled) {
+		auto spirv = uncached();
+		std::lock_guard<std::mutex> lock(mShaderCacheMutex);
+		mShaderCacheStatistics.secondsSpentCompiling += secondsSince(t0);
+		return spirv;
+	}
+
+	const auto key = computeShaderCacheKey(shaderSource, includeBaseDirectory, options, stageForKey);
+	std::vector<uint32_t> spirv;
+	if (tryLoadSpirvFromShaderCache(key, spirv, out_includedFiles)) {
+		std::lock_guard<std::mutex> lock(mShaderCacheMutex);
+		++mShaderCacheStatistics.hits;
+		mShaderCacheStatistics.secondsSpentLoadingFromCache += secondsSince(t0);
+		return spirv;
+	}
+
+	spirv = uncached();
+	{
+		std::lock_guard<std::mutex> lock(mShaderCacheMutex);
+		++mShaderCacheStatistics.misses;
+		mShaderCacheStatistics.secondsSpentCompiling += secondsSince(t0);
+	}
+	if (!spirv.empty()) { // Don't cache failed compilations
+		storeSpirvInShaderCache(key, spirv, out_includedFiles);
+	}
+	return spirv;
+#endif
+}
+
+void vklSetWorkerThreadCount(uint32_t thread_count)
+{
+	// Wait for all jobs of the current worker threads, the new count is applied when the next job is submitted:
+	mWorkerPool.stop();
+	mWorkerPool.mThreadCount = thread_count;
+}
+
+void vklConfigureShaderCache(const VklShaderCacheConfig& config)
+{
+	mShaderCacheConfig = config;
+	mShaderCacheDirectory = nullptr != config.cacheDirectory ? config.cacheDirectory : "";
+	if (mShaderCacheDirectory.empty()) {
+		mShaderCacheConfig.enabled = false;
+	}
+	mShaderCacheConfig.cacheDirectory = mShaderCacheDirectory.c_str();
+}
+
+VklShaderCacheStatistics vklGetShaderCacheStatistics()
+{
+	std::lock_guard<std::mutex> lock(mShaderCacheMutex);
+	return mShaderCacheStatistics;
+}
+
+VklPipelineCacheConfig mPipelineCacheConfig = {};
+std::string mPipelineCacheFilePath = mPipelineCacheConfig.cacheFilePath;
+vk::PipelineCache mPipelineCache; // Used for all pipelines created by the framework. VkPipelineCache is internally synchronized.
+VklPipelineCacheStatistics mPipelineCacheStatistics = {};
+std::mutex mPipelineCacheStatisticsMutex; // Pipelines are created on multiple threads concurrently
+
+// Returns true if the given pipeline cache data has been created by the same driver for the same device,
+// i.e., if its header matches vendorID, deviceID, and pipelineCacheUUID of the physical device in use.
+bool isPipelineCacheDataCompatible(const std::vector<char>& data, const vk::PhysicalDeviceProperties& properties)
+{
+	VkPipelineCacheHeaderVersionOne header = {};
+	if (data.size() < sizeof(header)) {
+		return false;
+	}
+	memcpy(&header, data.data(), sizeof(header));
+	return header.headerSize >= sizeof(header) && header.headerSize <= data.size()
+		&& VK_PIPELINE_CACHE_HEADER_VERSION_ONE == header.headerVersion
+		&& properties.vendorID == header.vendorID
+		&& properties.deviceID == header.deviceID
+		&& 0 == memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID.data(), VK_UUID_SIZE);
+}
+
+// Creates the framework's pipeline cache, seeded with the data from the cache file if it is compatible with the device.
+void createPipelineCache()
+{
+	std::vector<char> initialData;
+	if (mPipelineCacheConfig.enabled) {
+		std::ifstream file(mPipelineCacheFilePath, std::ios::binary);
+		if (file.good()) {
+			initialData.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+			if (!isPipelineCacheDataCompatible(initialData, mPhysicalDevice.getProperties())) {
+				VKL_LOG("Discarding pipeline cache file[" << mPipelineCacheFilePath << "], because it has been created by a different device or driver.");
+				initialData.clear();
+			}
+		}
+	}
+
+	mPipelineCache = mDevice.createPipelineCache(vk::PipelineCacheCreateInfo{}
+		.setInitialDataSize(initialData.size())
+		.setPInitialData(initialData.empty() ? nullptr : initialData.data())
+	);
+	std::lock_guard<std::mutex> lock(mPipelineCacheStatisticsMutex);
+	mPipelineCacheStatistics.loadedCacheSizeInBytes = initialData.size();
+}
+
+// Writes the pipeline cache's data to the cache file, and destroys the pipeline cache.
+void saveAndDestroyPipelineCache()
+{
+	if (!mPipelineCache) {
+		return;
+	}
+	if (mPipelineCacheConfig.enabled) {
+		const auto data = mDevice.getPipelineCacheData(mPipelineCache);
+		std::error_code ec;
+		const auto path = std::filesystem::path(mPipelineCacheFilePath);
+		if (path.has_parent_path()) {
+			std::filesystem::create_directories(path.parent_path(), ec);
+		}
+		// Write to a temporary file first, so that an interrupted write never leaves a truncated cache file behind:
+		auto tmpPath = path;
+		tmpPath += ".tmp";
+		std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+		file.close();
+		if (file.good()) {
+			std::filesystem::rename(tmpPath, path, ec);
+		}
+		if (!file.good() || ec) {
+			VKL_WARNING("Unable to write pipeline cache file[" << mPipelineCacheFilePath << "].");
+			std::filesystem::remove(tmpPath, ec);
+		}
+	}
+	mDevice.destroyPipelineCache(mPipelineCache);
+	mPipelineCache = nullptr;
+}
+
+VklShaderModuleCacheConfig mShaderModuleCacheConfig = {};
+VklShaderModuleCacheStatistics mShaderModuleCacheStatistics = {};
+std::mutex mShaderModuleCacheMutex; // Shader modules are requested on multiple threads concurrently
+bool mShaderModuleIdentifiersInUse = false;
+std::mutex mShaderModuleIdentifiersMutex;
+std::unordered_map<VkShaderModule, std::vector<uint8_t>> mShaderModuleIdentifiers; // Of all shader modules created by the shader module cache
+
+// Returns true if the device supports VK_EXT_shader_module_identifier and its shaderModuleIdentifier feature.
+bool isShaderModuleIdentifierSupported()
+{
+#ifdef VK_EXT_shader_module_identifier
+	const auto extensions = mPhysicalDevice.enumerateDeviceExtensionProperties();
+	const bool hasExtension = std::any_of(std::begin(extensions), std::end(extensions), [](const vk::ExtensionProperties& extension) {
+		return 0 == strcmp(extension.extensionName, VK_EXT_SHADER_MODULE_IDENTIFIER_EXTENSION_NAME);
+	});
+	if (!hasExtension || mPhysicalDevice.getProperties().apiVersion < VK_API_VERSION_1_1) {
+		return false;
+	}
+	auto features = mPhysicalDevice.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceShaderModuleIdentifierFeaturesEXT>();
+	return VK_TRUE == features.get<vk::PhysicalDeviceShaderModuleIdentifierFeaturesEXT>().shaderModuleIdentifier;
+#else
+	return false;
+#endif
+}
+
+// Tries to create the given graphics pipelines from the identifiers of their shader modules instead of from the modules themselves.
+// This only succeeds for pipelines which the driver finds in the pipeline cache. Returns null handles for all pipelines which
+// have not been created, i.e., which have to be created from their shader modules.
+std::vector<vk::Pipeline> tryCreateGraphicsPipelinesFromModuleIdentifiers(const std::vector<vk::GraphicsPipelineCreateInfo>& pipelineCreateInfos)
+{
+	std::vector<vk::Pipeline> graphicsPipelines(pipelineCreateInfos.size());
+#ifdef VK_EXT_shader_module_identifier
+	if (!mShaderModuleIdentifiersInUse) {
+		return graphicsPipelines;
+	}
+	// All pipelines whose modules' identifiers are known are created with a single call. The ones which are not in the cache fail individually:
+	std::vector<std::vector<vk::PipelineShaderStageCreateInfo>> stages(pipelineCreateInfos.size());
+	std::vector<std::vector<std::vector<uint8_t>>> identifiers(pipelineCreateInfos.size());
+	std::vector<std::vector<vk::PipelineShaderStageModuleIdentifierCreateInfoEXT>> identifierCreateInfos(pipelineCreateInfos.size());
+	std::vector<size_t> identifiedIndices;
+	std::vector<VkGraphicsPipelineCreateInfo> identifiedCreateInfos;
+	for (size_t i = 0; i < pipelineCreateInfos.size(); ++i) {
+		const auto& createInfo = pipelineCreateInfos[i];
+		if (0 == createInfo.stageCount) {
+			continue; // E.g., pipelines which are linked from libraries
+		}
+		stages[i].assign(createInfo.pStages, createInfo.pStages + createInfo.stageCount);
+		identifiers[i].resize(stages[i].size());
+		{
+			std::lock_guard<std::mutex> lock(mShaderModuleIdentifiersMutex);
+			for (size_t j = 0; j < stages[i].size(); ++j) {
+				auto it = mShaderModuleIdentifiers.find(static_cast<VkShaderModule>(stages[i][j].module));
+				if (mShaderModuleIdentifiers.end() != it) {
+					identifiers[i][j] = it->second;
+				}
+			}
+		}
+		if (std::any_of(std::begin(identifiers[i]), std::end(identifiers[i]), [](const std::vector<uint8_t>& identifier) { return identifier.empty(); })) {
+			continue;
+		}
+
+		identifierCreateInfos[i].resize(stages[i].size());
+		for (size_t j = 0; j < stages[i].size(); ++j) {
+			identifierCreateInfos[i][j]
+				.setPNext(stages[i][j].pNext)
+				.setIdentifierSize(static_cast<uint32_t>(identifiers[i][j].size()))
+				.setPIdentifier(identifiers[i][j].data());
+			stages[i][j].setPNext(&identifierCreateInfos[i][j]).setModule(nullptr);
+		}
+		identifiedIndices.push_back(i);
+		identifiedCreateInfos.push_back(vk::GraphicsPipelineCreateInfo{ createInfo }
+			.setFlags(createInfo.flags | vk::PipelineCreateFlagBits::eFailOnPipelineCompileRequiredEXT)
+			.setPStages(stages[i].data()));
+	}
+	if (identifiedCreateInfos.empty()) {
+		return graphicsPipelines;
+	}
+
+	// Use the C function, since VK_PIPELINE_COMPILE_REQUIRED is an expected result here:
+	std::vector<VkPipeline> identifiedPipelines(identifiedCreateInfos.size(), VK_NULL_HANDLE);
+	vkCreateGraphicsPipelines(static_cast<VkDevice>(mDevice), static_cast<VkPipelineCache>(mPipelineCache), static_cast<uint32_t>(identifiedCreateInfos.size()), identifiedCreateInfos.data(), nullptr, identifiedPipelines.data());
+	uint32_t numCreated = 0;
+	for (size_t k = 0; k < identifiedIndices.size(); ++k) {
+		if (VK_NULL_HANDLE != identifiedPipelines[k]) {
+			graphicsPipelines[identifiedIndices[k]] = identifiedPipelines[k];
+			++numCreated;
+		}
+	}
+	std::lock_guard<std::mutex> lock(mShaderModuleCacheMutex);
+	mShaderModuleCacheStatistics.pipelinesCreatedFromIdentifiers += numCreated;
+#endif
+	return graphicsPipelines;
+}
+
+// Creates graphics pipelines with a single vkCreateGraphicsPipelines call, using the framework's pipeline cache. If enabled,
+// VK_EXT_pipeline_creation_feedback is requested, and whether the pipeline cache has been hit and how long the creation took is recorded and logged.
+std::vector<vk::Pipeline> createGraphicsPipelinesWithFeedback(std::vector<vk::GraphicsPipelineCreateInfo> pipelineCreateInfos)
+{
+	const auto t0 = std::chrono::steady_clock::now();
+#ifdef VK_EXT_pipeline_creation_feedback
+	std::vector<vk::PipelineCreationFeedbackEXT> pipelineFeedbacks(pipelineCreateInfos.size());
+	std::vector<std::vector<vk::PipelineCreationFeedbackEXT>> stageFeedbacks(pipelineCreateInfos.size());
+	std::vector<vk::PipelineCreationFeedbackCreateInfoEXT> feedbackCreateInfos(pipelineCreateInfos.size());
+	if (mPipelineCacheConfig.reportCreationFeedback) {
+		for (size_t i = 0; i < pipelineCreateInfos.size(); ++i) {
+			stageFeedbacks[i].resize(pipelineCreateInfos[i].stageCount);
+			feedbackCreateInfos[i]
+				.setPNext(pipelineCreateInfos[i].pNext)
+				.setPPipelineCreationFeedback(&pipelineFeedbacks[i])
+				.setPipelineStageCreationFeedbackCount(static_cast<uint32_t>(stageFeedbacks[i].size()))
+				.setPPipelineStageCreationFeedbacks(stageFeedbacks[i].data());
+			pipelineCreateInfos[i].setPNext(&feedbackCreateInfos[i]);
+		}
+	}
+#endif
+
+	auto graphicsPipelines = mDevice.createGraphicsPipelines(mPipelineCache, pipelineCreateInfos).value;
+
+	const auto secondsSpent = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+	uint32_t numFeedbacksValid = 0;
+	uint32_t numCacheHits = 0;
+#ifdef VK_EXT_pipeline_creation_feedback
+	for (const auto& pipelineFeedback : pipelineFeedbacks) {
+		if (mPipelineCacheConfig.reportCreationFeedback && (pipelineFeedback.flags & vk::PipelineCreationFeedbackFlagBitsEXT::eValid)) {
+			const bool cacheHit = static_cast<bool>(pipelineFeedback.flags & vk::PipelineCreationFeedbackFlagBitsEXT::eApplicationPipelineCacheHit);
+			++numFeedbacksValid;
+			numCacheHits += cacheHit ? 1 : 0;
+			VKL_LOG("Created graphics pipeline in " << (static_cast<double>(pipelineFeedback.duration) / 1e6) << " ms according to the driver, pipeline cache " << (cacheHit ? "hit" : "miss") << ".");
+		}
+	}
+#endif
+
+	std::lock_guard<std::mutex> lock(mPipelineCacheStatisticsMutex);
+	mPipelineCacheStatistics.pipelinesCreated += static_cast<uint32_t>(graphicsPipelines.size());
+	mPipelineCacheStatistics.secondsSpentCreatingPipelines += secondsSpent;
+	mPipelineCacheStatistics.pipelinesWithFeedback += numFeedbacksValid;
+	mPipelineCacheStatistics.cacheHits += numCacheHits;
+	return graphicsPipelines;
+}
+
+// Creates graphics pipelines, preferably from the identifiers of their shader modules if these are in use,
+// and from their shader modules (with a single vkCreateGraphicsPipelines call) otherwise.
+std::vector<vk::Pipeline> createGraphicsPipelinesFromModulesOrIdentifiers(const std::vector<vk::GraphicsPipelineCreateInfo>& pipelineCreateInfos)
+{
+	auto graphicsPipelines = tryCreateGraphicsPipelinesFromModuleIdentifiers(pipelineCreateInfos);
+	std::vector<size_t> remainingIndices;
+	std::vector<vk::GraphicsPipelineCreateInfo> remainingCreateInfos;
+	for (size_t i = 0; i < graphicsPipelines.size(); ++i) {
+		if (!graphicsPipelines[i]) {
+			remainingIndices.push_back(i);
+			remainingCreateInfos.push_back(pipelineCreateInfos[i]);
+		}
+	}
+	if (remainingCreateInfos.empty()) {
+		return graphicsPipelines;
+	}
+	auto remainingPipelines = createGraphicsPipelinesWithFeedback(std::move(remainingCreateInfos));
+	for (size_t i = 0; i < remainingIndices.size(); ++i) {
+		graphicsPipelines[remainingIndices[i]] = remainingPipelines[i];
+	}
+	return graphicsPipelines;
+}
+
+void vklConfigurePipelineCache(const VklPipelineCacheConfig& config)
+{
+	mPipelineCacheConfig = config;
+	mPipelineCacheFilePath = nullptr != config.cacheFilePath ? config.cacheFilePath : "";
+	if (mPipelineCacheFilePath.empty()) {
+		mPipelineCacheConfig.enabled = false;
+	}
+	mPipelineCacheConfig.cacheFilePath = mPipelineCacheFilePath.c_str();
+}
+
+VklPipelineCacheStatistics vklGetPipelineCacheStatistics()
+{
+	std::lock_guard<std::mutex> lock(mPipelineCacheStatisticsMutex);
+	return mPipelineCacheStatistics;
+}
+
+// The GLSL code of one shader stage, and where it has been loaded from:
+struct VklShaderSource {
+	std::string mName;
+	std::string mCode;
+	std::string mIncludeBaseDirectory; // #include directives are resolved relative to this directory
+	std::vector<VklShaderFileDependency> mFiles; // The shader file, unless the code has been passed from memory
+};
+
+// The result of compiling one shader stage:
+struct VklCompiledShader {
+	std::vector<uint32_t> mSpirv; // Empty if compilation failed
+	std::vector<VklShaderFileDependency> mFiles; // The shader file and all files #included by it
+};
+
+// Compiles the given GLSL shader code for the given shader stage.
+// This function can be invoked from multiple threads concurrently.
+VklCompiledShader compileShaderStageToSpirv(const VklShaderSource& source, const VklShaderCompileOptions& options, const vk::ShaderStageFlagBits shaderStage)
+{
+	VklCompiledShader result;
+	std::vector<VklShaderFileDependency> includedFiles;
+#ifdef USE_SHADERC
+	shaderc_shader_kind shadercKind;
+	switch (shaderStage) {
+	case vk::ShaderStageFlagBits::eVertex: shadercKind = shaderc_shader_kind::shaderc_vertex_shader; break;
+	case vk::ShaderStageFlagBits::eTessellationControl: shadercKind = shaderc_shader_kind::shaderc_tess_control_shader; break;
+	case vk::ShaderStageFlagBits::eTessellationEvaluation: shadercKind = shaderc_shader_kind::shaderc_tess_evaluation_shader; break;
+	case vk::ShaderStageFlagBits::eGeometry: shadercKind = shaderc_shader_kind::shaderc_geometry_shader; break;
+	case vk::ShaderStageFlagBits::eFragment: shadercKind = shaderc_shader_kind::shaderc_fragment_shader; break;
+	case vk::ShaderStageFlagBits::eCompute: shadercKind = shaderc_shader_kind::shaderc_compute_shader; break;
+	case vk::ShaderStageFlagBits::eRaygenKHR: shadercKind = shaderc_shader_kind::shaderc_raygen_shader; break;
+	case vk::ShaderStageFlagBits::eAnyHitKHR: shadercKind = shaderc_shader_kind::shaderc_anyhit_shader; break;
+	case vk::ShaderStageFlagBits::eClosestHitKHR: shadercKind = shaderc_shader_kind::shaderc_closesthit_shader; break;
+	case vk::ShaderStageFlagBits::eMissKHR: shadercKind = shaderc_shader_kind::shaderc_miss_shader; break;
+	case vk::ShaderStageFlagBits::eIntersectionKHR: shadercKind = shaderc_shader_kind::shaderc_intersection_shader; break;
+	case vk::ShaderStageFlagBits::eCallableKHR: shadercKind = shaderc_shader_kind::shaderc_callable_shader; break;
+	case vk::ShaderStageFlagBits::eTaskNV: shadercKind = shaderc_shader_kind::shaderc_task_shader; break;
+	case vk::ShaderStageFlagBits::eMeshNV: shadercKind = shaderc_shader_kind::shaderc_mesh_shader; break;
+	}
+	result.mSpirv = compileShaderSourceToSpirv(source.mCode, source.mName, source.mIncludeBaseDirectory, options, includedFiles, shadercKind);
+#endif
+#ifdef USE_GLSLANG
+	glslang_stage_t glslangStage;
+	switch (shaderStage) {
+	case vk::ShaderStageFlagBits::eVertex: glslangStage = GLSLANG_STAGE_VERTEX; break;
+	case vk::ShaderStageFlagBits::eTessellationControl: glslangStage = GLSLANG_STAGE_TESSCONTROL; break;
+	case vk::ShaderStageFlagBits::eTessellationEvaluation: glslangStage = GLSLANG_STAGE_TESSEVALUATION; break;
+	case vk::ShaderStageFlagBits::eGeometry: glslangStage = GLSLANG_STAGE_GEOMETRY; break;
+	case vk::ShaderStageFlagBits::eFragment: glslangStage = GLSLANG_STAGE_FRAGMENT; break;
+	case vk::ShaderStageFlagBits::eCompute: glslangStage = GLSLANG_STAGE_COMPUTE; break;
+	case vk::ShaderStageFlagBits::eRaygenKHR: glslangStage = GLSLANG_STAGE_RAYGEN; break;
+	case vk::ShaderStageFlagBits::eAnyHitKHR: glslangStage = GLSLANG_STAGE_ANYHIT; break;
+	case vk::ShaderStageFlagBits::eClosestHitKHR: glslangStage = GLSLANG_STAGE_CLOSESTHIT; break;
+	case vk::ShaderStageFlagBits::eMissKHR: glslangStage = GLSLANG_STAGE_MISS; break;
+	case vk::ShaderStageFlagBits::eIntersectionKHR: glslangStage = GLSLANG_STAGE_INTERSECT; break;
+	case vk::ShaderStageFlagBits::eCallableKHR: glslangStage = GLSLANG_STAGE_CALLABLE; break;
+	case vk::ShaderStageFlagBits::eTaskNV: glslangStage = GLSLANG_STAGE_TASK; break;
+	case vk::ShaderStageFlagBits::eMeshNV: glslangStage = GLSLANG_STAGE_MESH; break;
+	}
+	result.mSpirv = compileShaderSourceToSpirv(source.mCode, source.mName, source.mIncludeBaseDirectory, options, includedFiles, glslangStage);
+#endif
+	result.mFiles = source.mFiles;
+	appendShaderFiles(result.mFiles, includedFiles);
+	return result;
+}
+
+// Wraps SPIR-V code which has been compiled before, e.g., at build time. It does not depend on any files.
+VklCompiledShader getPrecompiledShader(const uint32_t* spirv, size_t spirvSizeInBytes)
+{
+	VklCompiledShader result;
+	result.mSpirv.assign(spirv, spirv + spirvSizeInBytes / sizeof(uint32_t));
+	return result;
+}
+
+// Returns the GLSL code of a shader stage, which is either read from the file at the given path,
+// or, if loadFromMemoryInstead is true, the given string is interpreted as GLSL code directly.
+VklShaderSource loadShaderSource(const char* shaderPathOrCode, bool loadFromMemoryInstead, const char* stageName)
+{
+	VklShaderSource source;
+	if (loadFromMemoryInstead) {
+		// Files included by shaders from memory are resolved relative to the working directory:
+		source.mName = std::string(stageName) + " shader from memory";
+		source.mCode = shaderPathOrCode;
+		return source;
+	}
+
+	VklShaderFileDependency file;
+	if (!readShaderFile(shaderPathOrCode, source.mCode, file)) { // Fail if shader file could not be found:
+		VKL_EXIT_WITH_ERROR("Unable to load file[" << shaderPathOrCode << "].");
+	}
+	VKL_LOG("Loading shader file from path[" << shaderPathOrCode << "]...");
+	source.mName = shaderPathOrCode;
+	source.mIncludeBaseDirectory = std::filesystem::path(shaderPathOrCode).parent_path().string();
+	source.mFiles.push_back(std::move(file));
+	return source;
+}
+
+// A compiled shader stage and its shader module, which are shared by all pipelines that use the same shader code for the same stage:
+struct VklCachedShaderModule {
+	VklCompiledShader mShader;
+	vk::ShaderStageFlagBits mStage;
+	vk::ShaderModule mModule; // Null if compilation failed
+
+	VklCachedShaderModule() = default;
+	VklCachedShaderModule(const VklCachedShaderModule&) = delete;
+	VklCachedShaderModule& operator=(const VklCachedShaderModule&) = delete;
+	~VklCachedShaderModule()
+	{
+		if (!mModule) {
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> lock(mShaderModuleIdentifiersMutex);
+			mShaderModuleIdentifiers.erase(static_cast<VkShaderModule>(mModule));
+		}
+		mDevice.destroyShaderModule(mModule);
+	}
+};
+using VklShaderModuleFuture = std::shared_future<std::shared_ptr<VklCachedShaderModule>>;
+
+// All cached shader modules by their key (and a unique number per entry), the most recently used one first:
+std::list<std::tuple<uint64_t, VklShaderModuleFuture, uint64_t>> mShaderModuleCacheEntries;
+std::unordered_map<uint64_t, std::list<std::tuple<uint64_t, VklShaderModuleFuture, uint64_t>>::iterator> mShaderModuleCacheIndex;
+uint64_t mShaderModuleCacheEntriesCreated = 0;
+
+// Creates a shader module from the given compiled shader. If shader module identifiers are in use, its identifier is queried, too.
+std::shared_ptr<VklCachedShaderModule> createCachedShaderModule(VklCompiledShader shader, const vk::ShaderStageFlagBits shaderStage)
+{
+	auto cached = std::make_shared<VklCachedShaderModule>();
+	cached->mShader = std::move(shader);
+	cached->mStage = shaderStage;
+	if (cached->mShader.mSpirv.empty()) {
+		return cached;
+	}
+
+	cached->mModule = mDevice.createShaderModule(vk::ShaderModuleCreateInfo{}
+		.setCodeSize(cached->mShader.mSpirv.size() * sizeof(uint32_t)) // Size must be specified in BYTE
+		.setPCode(cached->mShader.mSpirv.data()));
+#ifdef VK_EXT_shader_module_identifier
+	if (mShaderModuleIdentifiersInUse) {
+		const auto identifier = mDevice.getShaderModuleIdentifierEXT(cached->mModule, mDynamicDispatch);
+		std::lock_guard<std::mutex> lock(mShaderModuleIdentifiersMutex);
+		mShaderModuleIdentifiers[static_cast<VkShaderModule>(cached->mModule)].assign(identifier.identifier.data(), identifier.identifier.data() + identifier.identifierSize);
+	}
+#endif
+	return cached;
+}
+
+// Returns the create info of the given shader module's stage. The entry point is "main" always.
+vk::PipelineShaderStageCreateInfo getShaderStageCreateInfo(const VklCachedShaderModule& cached)
+{
+	return vk::PipelineShaderStageCreateInfo{}
+		.setStage(cached.mStage)
+		.setModule(cached.mModule)
+		.setPName("main"); // entry point
+}
+
+// Returns false if the given cache entry must not be used anymore, i.e., if its shader failed to compile, or if any of the files it has
+// been compiled from have changed since. Entries which are still being created are always used, they are based on the latest files.
+bool isCachedShaderModuleUpToDate(const VklShaderModuleFuture& future)
+{
+	if (std::future_status::ready != future.wait_for(std::chrono::seconds(0))) {
+		return true;
+	}
+	std::shared_ptr<VklCachedShaderModule> cached;
+	try {
+		cached = future.get();
+	}
+	catch (const std::exception&) {
+		return false;
+	}
+	if (!cached->mModule) {
+		return false;
+	}
+	auto files = cached->mShader.mFiles;
+	std::unordered_map<std::string, VklShaderFileDependency> filesReadDuringThisCheck;
+	return std::none_of(std::begin(files), std::end(files), [&filesReadDuringThisCheck](VklShaderFileDependency& file) { return hasShaderFileChanged(file, filesReadDuringThisCheck); });
+}
+
+// Returns the shader module with the given key from the cache. If it is not in the cache, the given function is used to compile the shader,
+// either on a worker thread, or on the first thread which waits for it. Concurrent requests for the same shader module share one compilation.
+template <typename F>
+VklShaderModuleFuture getOrCreateShaderModule(uint64_t key, const vk::ShaderStageFlagBits shaderStage, bool onWorkerThread, F&& compile)
+{
+	auto create = [compile = std::forward<F>(compile), shaderStage]() {
+		return createCachedShaderModule(compile(), shaderStage);
+	};
+	const auto launch = [&create, onWorkerThread]() -> VklShaderModuleFuture {
+		if (onWorkerThread) {
+			return submitWorkerJob(std::move(create)).share();
+		}
+		return std::async(std::launch::deferred, std::move(create)).share();
+	};
+
+	// Whether the files of a cached entry have changed is checked without holding the lock, since it involves file I/O:
+	VklShaderModuleFuture cachedFuture;
+	uint64_t cachedEntryNumber = 0;
+	{
+		std::lock_guard<std::mutex> lock(mShaderModuleCacheMutex);
+		if (!mShaderModuleCacheConfig.enabled) {
+			++mShaderModuleCacheStatistics.misses;
+			return launch();
+		}
+		auto it = mShaderModuleCacheIndex.find(key);
+		if (mShaderModuleCacheIndex.end() != it) {
+			cachedFuture = std::get<1>(*it->second);
+			cachedEntryNumber = std::get<2>(*it->second);
+		}
+	}
+	const bool cachedUpToDate = cachedFuture.valid() && isCachedShaderModuleUpToDate(cachedFuture);
+
+	std::lock_guard<std::mutex> lock(mShaderModuleCacheMutex);
+	auto it = mShaderModuleCacheIndex.find(key);
+	if (mShaderModuleCacheIndex.end() != it) {
+		// Entries which have been replaced by another thread in the meantime are based on the latest files, too:
+		if (cachedUpToDate || std::get<2>(*it->second) != cachedEntryNumber) {
+			// Mark it as the most recently used one:
+			mShaderModuleCacheEntries.splice(std::begin(mShaderModuleCacheEntries), mShaderModuleCacheEntries, it->second);
+			++mShaderModuleCacheStatistics.hits;
+			return std::get<1>(*it->second);
+		}
+		mShaderModuleCacheEntries.erase(it->second);
+		mShaderModuleCacheIndex.erase(it);
+	}
+
+	++mShaderModuleCacheStatistics.misses;
+	auto future = launch();
+	mShaderModuleCacheEntries.emplace_front(key, future, ++mShaderModuleCacheEntriesCreated);
+	mShaderModuleCacheIndex[key] = std::begin(mShaderModuleCacheEntries);
+	// Release the least recently used ones. Pipelines which are still being created keep their shader modules alive:
+	while (0 != mShaderModuleCacheConfig.maxShaderModules && mShaderModuleCacheEntries.size() > mShaderModuleCacheConfig.maxShaderModules) {
+		mShaderModuleCacheIndex.erase(std::get<0>(mShaderModuleCacheEntries.back()));
+		mShaderModuleCacheEntries.pop_back();
+		++mShaderModuleCacheStatistics.evictions;
+	}
+	return future;
+}
+
+// Returns the shader module of the given GLSL shader stage from the cache, or compiles it (on a worker thread, if requested).
+VklShaderModuleFuture getOrCompileShaderModule(VklShaderSource source, const VklShaderCompileOptions& options, const vk::ShaderStageFlagBits shaderStage, bool onWorkerThread)
+{
+	// The name (i.e., the path) is part of the key, since the cached module records the files it has been compiled from, which
+	// become the hot-reload dependencies of every pipeline using it. Files with identical code must not share these:
+	const auto key = hashString(source.mName, computeShaderCacheKey(source.mCode, source.mIncludeBaseDirectory, options, static_cast<int>(shaderStage)));
+	return getOrCreateShaderModule(key, shaderStage, onWorkerThread, [source = std::move(source), options, shaderStage]() {
+		return compileShaderStageToSpirv(source, options, shaderStage);
+	});
+}
+
+// Returns the shader module of the given precompiled SPIR-V code from the cache, or creates it.
+VklShaderModuleFuture getOrCreatePrecompiledShaderModule(const uint32_t* spirv, size_t spirvSizeInBytes, const vk::ShaderStageFlagBits shaderStage)
+{
+	const auto stage = static_cast<uint32_t>(shaderStage);
+	const auto key = hashBytes(spirv, spirvSizeInBytes, hashBytes(&stage, sizeof(stage), hashString("precompiled")));
+	return getOrCreateShaderModule(key, shaderStage, /* on worker thread: */ false, [spirv, spirvSizeInBytes]() {
+		return getPrecompiledShader(spirv, spirvSizeInBytes);
+	});
+}
+
+void vklConfigureShaderModuleCache(const VklShaderModuleCacheConfig& config)
+{
+	std::lock_guard<std::mutex> lock(mShaderModuleCacheMutex);
+	mShaderModuleCacheConfig = config;
+}
+
+VklShaderModuleCacheStatistics vklGetShaderModuleCacheStatistics()
+{
+	std::lock_guard<std::mutex> lock(mShaderModuleCacheMutex);
+	return mShaderModuleCacheStatistics;
+}
+
+void vklPurgeShaderModuleCache()
+{
+	std::lock_guard<std::mutex> lock(mShaderModuleCacheMutex);
+	mShaderModuleCacheIndex.clear();
+	mShaderModuleCacheEntries.clear();
+}
+
+// All the objects which make up a (graphics or compute) pipeline created by the framework:
+struct VklPipelineObjects {
+	vk::Pipeline mPipeline;
+	std::shared_ptr<VklPipelineLayouts> mLayouts;
+	std::vector<VklShaderFileDependency> mShaderFiles; // All files the pipeline's shaders have been compiled from
+	uint64_t mSpirvHash = 0; // Of the SPIR-V of all stages, 0 if unknown
+	bool mSpirvUnchanged = false; // Set by hot-reloads which did not create a pipeline, because the SPIR-V is identical to the current pipeline's
+};
+
+// All the state which the create info of a graphics pipeline points to. Since mCreateInfo points into the other members,
+// a description must not be copied or moved after describeGraphicsPipeline has filled it.
+struct VklGraphicsPipelineDescription {
+	std::array<vk::PipelineShaderStageCreateInfo, 2> mShaderStages;
+	std::array<std::vector<vk::SpecializationMapEntry>, 2> mSpecializationMapEntries;
+	std::array<std::vector<uint32_t>, 2> mSpecializationData;
+	std::array<vk::SpecializationInfo, 2> mSpecializationInfos;
+	std::vector<vk::VertexInputBindingDescription> mInputBufferBindings;
+	std::vector<vk::VertexInputAttributeDescription> mInputAttributeDescriptions;
+	vk::PipelineVertexInputStateCreateInfo mVertexInputState;
+	vk::PipelineInputAssemblyStateCreateInfo mInputAssemblyState;
+	vk::Viewport mViewport;
+	vk::Rect2D mScissors;
+	vk::PipelineViewportStateCreateInfo mViewportState;
+	vk::PipelineRasterizationStateCreateInfo mRasterizerState;
+	vk::PipelineMultisampleStateCreateInfo mMultisampleState;
+	vk::PipelineDepthStencilStateCreateInfo mDepthStencilState;
+	vk::PipelineColorBlendAttachmentState mColorBlendAttachmentState;
+	vk::PipelineColorBlendStateCreateInfo mColorBlendState;
+	std::vector<vk::DynamicState> mDynamicStates;
+	vk::PipelineDynamicStateCreateInfo mDynamicState;
+	std::shared_ptr<VklPipelineLayouts> mLayouts;
+	vk::GraphicsPipelineCreateInfo mCreateInfo;
+};
+
+std::mutex mInternedPipelineLayoutsMutex; // Layouts are requested on multiple threads concurrently
+// Interned layouts by the hash of their key data, together with the key data itself, so that hash collisions are told apart:
+std::unordered_multimap<uint64_t, std::tuple<std::vector<uint64_t>, std::weak_ptr<VklPipelineLayouts>>> mInternedPipelineLayouts;
+
+// Returns the descriptor set layout bindings and push constant ranges of the given (graphics or compute) pipeline config in a
+// canonical form, i.e., one which does not depend on the order in which the bindings are specified.
+template <typename TPipelineConfig>
+std::vector<uint64_t> getPipelineLayoutKeyData(const TPipelineConfig& config)
+{
+	auto bindings = config.descriptorLayout;
+	std::sort(std::begin(bindings), std::end(bindings), [](const VkDescriptorSetLayoutBinding& a, const VkDescriptorSetLayoutBinding& b) { return a.binding < b.binding; });
+	std::vector<uint64_t> data;
+	data.reserve(2 + bindings.size() * 5 + config.pushConstantRanges.size() * 3);
+	data.push_back(bindings.size());
+	for (const auto& binding : bindings) {
+		data.insert(std::end(data), { binding.binding, static_cast<uint64_t>(binding.descriptorType), binding.descriptorCount, binding.stageFlags, reinterpret_cast<uintptr_t>(binding.pImmutableSamplers) });
+	}
+	data.push_back(config.pushConstantRanges.size());
+	for (const auto& range : config.pushConstantRanges) {
+		data.insert(std::end(data), { range.stageFlags, range.offset, range.size });
+	}
+	return data;
+}
+
+uint64_t hashPipelineLayoutKeyData(const std::vector<uint64_t>& data)
+{
+	return hashBytes(data.data(), data.size() * sizeof(uint64_t), hashString("pipeline layout"));
+}
+
+// Computes a canonical hash of the descriptor set layout bindings and push constant ranges of the given (graphics or compute) pipeline config.
+template <typename TPipelineConfig>
+uint64_t computePipelineLayoutKey(const TPipelineConfig& config)
+{
+	return hashPipelineLayoutKeyData(getPipelineLayoutKeyData(config));
+}
+
+// Creates the descriptor set layout and the pipeline layout for the given config.
+template <typename TPipelineConfig>
+std::shared_ptr<VklPipelineLayouts> createPipelineLayouts(const TPipelineConfig& config)
+{
+	std::vector<vk::DescriptorSetLayoutBinding> layoutBindings(std::begin(config.descriptorLayout), std::end(config.descriptorLayout));
+	std::vector<vk::PushConstantRange> pushConstantRanges(std::begin(config.pushConstantRanges), std::end(config.pushConstantRanges));
+	auto descriptorSetLayout = mDevice.createDescriptorSetLayoutUnique(
+		vk::DescriptorSetLayoutCreateInfo{}
+			.setBindingCount(static_cast<uint32_t>(layoutBindings.size()))
+			.setPBindings(layoutBindings.data())
+		, nullptr, mDispatchLoader
+	);
+
+	// Continue with configuring our pipeline:
+	// Create a PIPELINE LAYOUT which describes all RESOURCES that are passed in to our pipeline (Resource Descriptors that we have created above)
+	auto pipelineLayout = mDevice.createPipelineLayoutUnique(
+		vk::PipelineLayoutCreateInfo{} // A pipeline's layout describes all resources used by a pipeline or in shaders.
+			.setSetLayoutCount(1u)
+			.setPSetLayouts(&descriptorSetLayout.get()) // We don't need the actual descriptors when defining the PIPELINE. The LAYOUT is sufficient at this point.
+			.setPushConstantRangeCount(static_cast<uint32_t>(pushConstantRanges.size()))
+			.setPPushConstantRanges(pushConstantRanges.data())
+		, nullptr, mDispatchLoader
+	);
+	return std::make_shared<VklPipelineLayouts>(VklPipelineLayouts{ std::move(descriptorSetLayout), std::move(pipelineLayout) });
+}
+
+// Returns the layouts for the given config, which are shared with all other pipelines with identical bindings and push constant ranges.
+// Pipelines which share their layouts are compatible for all descriptor sets, i.e., bound descriptor sets stay valid when switching between them.
+template <typename TPipelineConfig>
+std::shared_ptr<VklPipelineLayouts> getOrCreatePipelineLayouts(const TPipelineConfig& config)
+{
+	auto data = getPipelineLayoutKeyData(config);
+	const auto key = hashPipelineLayoutKeyData(data);
+	std::lock_guard<std::mutex> lock(mInternedPipelineLayoutsMutex);
+	auto range = mInternedPipelineLayouts.equal_range(key);
+	auto interned = std::find_if(range.first, range.second, [&data](const auto& entry) { return std::get<std::vector<uint64_t>>(entry.second) == data; });
+	if (range.second == interned) {
+		interned = mInternedPipelineLayouts.emplace(key, std::make_tuple(std::move(data), std::weak_ptr<VklPipelineLayouts>{}));
+	}
+	auto layouts = std::get<std::weak_ptr<VklPipelineLayouts>>(interned->second).lock();
+	if (!layouts) {
+		layouts = createPipelineLayouts(config);
+		std::get<std::weak_ptr<VklPipelineLayouts>>(interned->second) = layouts;
+	}
+	return layouts;
+}
+
+// Hashes the given specialization constants regardless of their order, so that equal sets of constants yield the same key:
+uint64_t hashSpecializationConstants(const std::vector<VklSpecializationConstant>& constants, uint64_t key)
+{
+	auto sorted = constants;
+	std::sort(std::begin(sorted), std::end(sorted), [](const VklSpecializationConstant& a, const VklSpecializationConstant& b) { return a.constantId < b.constantId; });
+	const uint64_t numConstants = sorted.size();
+	key = hashBytes(&numConstants, sizeof(numConstants), key);
+	for (const auto& constant : sorted) {
+		const uint32_t values[] = { constant.constantId, constant.value };
+		key = hashBytes(values, sizeof(values), key);
+	}
+	return key;
+}
+
+VklSpecializationConstant vklFloatSpecializationConstant(uint32_t constant_id, float value)
+{
+	static_assert(sizeof(float) == sizeof(uint32_t), "Specialization constants are 32 bits wide.");
+	VklSpecializationConstant constant;
+	constant.constantId = constant_id;
+	memcpy(&constant.value, &value, sizeof(value));
+	return constant;
+}
+
+// Fills the given specialization info (and the map entries and data it points to) with the given constants, and lets the stage point to it.
+// The info, entries, and data must neither be copied nor moved afterwards.
+void describeSpecialization(vk::PipelineShaderStageCreateInfo& stage, const std::vector<VklSpecializationConstant>& constants,
+	std::vector<vk::SpecializationMapEntry>& mapEntries, std::vector<uint32_t>& data, vk::SpecializationInfo& info)
+{
+	if (constants.empty()) {
+		return;
+	}
+	for (const auto& constant : constants) {
+		mapEntries.push_back(vk::SpecializationMapEntry{ constant.constantId, static_cast<uint32_t>(data.size() * sizeof(uint32_t)), sizeof(uint32_t) });
+		data.push_back(constant.value);
+	}
+	info = vk::SpecializationInfo{}
+		.setMapEntryCount(static_cast<uint32_t>(mapEntries.size())).setPMapEntries(mapEntries.data())
+		.setDataSize(data.size() * sizeof(uint32_t)).setPData(data.data());
+	stage.setPSpecializationInfo(&info);
+}
+
+// Describes a graphics pipeline for the given config and shader stages, and creates its descriptor set layout and pipeline layout.
+// It does not touch any of the framework's bookkeeping data structures, so that it can be invoked from worker threads.
+void describeGraphicsPipeline(VklGraphicsPipelineDescription& d, const VklGraphicsPipelineConfig& config, const vk::PipelineShaderStageCreateInfo& vertexStage, const vk::PipelineShaderStageCreateInfo& fragmentStage)
+{
+	// Describe the shaders used:
+	d.mShaderStages = { vertexStage, fragmentStage };
+	// Specialize them, which does not require compiling them again, i.e., all variants share the same shader modules:
+	const std::array<const std::vector<VklSpecializationConstant>*, 2> specializationConstants = { &config.vertexShaderSpecializationConstants, &config.fragmentShaderSpecializationConstants };
+	for (size_t i = 0; i < d.mShaderStages.size(); ++i) {
+		describeSpecialization(d.mShaderStages[i], *specializationConstants[i], d.mSpecializationMapEntries[i], d.mSpecializationData[i], d.mSpecializationInfos[i]);
+	}
+	// Describe the vertex input, i.e. two vertex input attributes in our case:
+
+	d.mInputBufferBindings.assign(std::begin(config.vertexInputBuffers), std::end(config.vertexInputBuffers));
+	d.mInputAttributeDescriptions.assign(std::begin(config.inputAttributeDescriptions), std::end(config.inputAttributeDescriptions));
+
+	d.mVertexInputState = vk::PipelineVertexInputStateCreateInfo{}
+		.setVertexBindingDescriptionCount(static_cast<uint32_t>(d.mInputBufferBindings.size())).setPVertexBindingDescriptions(d.mInputBufferBindings.data())
+		.setVertexAttributeDescriptionCount(static_cast<uint32_t>(d.mInputAttributeDescriptions.size())).setPVertexAttributeDescriptions(d.mInputAttributeDescriptions.data());
+	// Describe the topology of the vertices
+	d.mInputAssemblyState = vk::PipelineInputAssemblyStateCreateInfo{}.setTopology(vk::PrimitiveTopology::eTriangleList);
+	// Describe viewport and scissors state
+	d.mViewport = vk::Viewport{}
+		.setX(0.0f).setY(0.0f)
+		.setWidth(static_cast<float>(mSwapchainConfig.imageExtent.width)).setHeight(static_cast<float>(mSwapchainConfig.imageExtent.height))
+		.setMinDepth(0.0f).setMaxDepth(1.0f);
+	d.mScissors = vk::Rect2D{}.setOffset({ 0, 0 }).setExtent(mSwapchainConfig.imageExtent);
+	d.mViewportState = vk::PipelineViewportStateCreateInfo{}
+		.setViewportCount(1u).setPViewports(&d.mViewport)
+		.setScissorCount(1u).setPScissors(&d.mScissors);
+	if (config.dynamicViewportAndScissor) {
+		// Viewport and scissor are set in vklStartRecordingCommands (or by the user), so that the pipeline does not depend on the resolution:
+		d.mViewportState.setPViewports(nullptr).setPScissors(nullptr);
+		d.mDynamicStates.push_back(vk::DynamicState::eViewport);
+		d.mDynamicStates.push_back(vk::DynamicState::eScissor);
+	}
+	d.mDynamicState = vk::PipelineDynamicStateCreateInfo{}
+		.setDynamicStateCount(static_cast<uint32_t>(d.mDynamicStates.size())).setPDynamicStates(d.mDynamicStates.data());
+	// Describe the rasterizer state
+	d.mRasterizerState = vk::PipelineRasterizationStateCreateInfo{}
+		.setPolygonMode(static_cast<vk::PolygonMode>(config.polygonDrawMode))
+		.setLineWidth(1.0f) // reasons...
+		.setCullMode(static_cast<vk::CullModeFlags>(config.triangleCullingMode))
+		.setFrontFace(vk::FrontFace::eCounterClockwise);
+	// Describe multisampling state
+	d.mMultisampleState = vk::PipelineMultisampleStateCreateInfo{}.setRasterizationSamples(vk::SampleCountFlagBits::e1);
+	// Configure depth/stencil state
+	d.mDepthStencilState = vk::PipelineDepthStencilStateCreateInfo{}
+		.setDepthTestEnable( mHasDepthAttachments ? VK_TRUE : VK_FALSE)
+		.setDepthWriteEnable(mHasDepthAttachments ? VK_TRUE : VK_FALSE)
+		.setDepthCompareOp(vk::CompareOp::eLess);
+	// Configure blending and which color channels are written
+	d.mColorBlendAttachmentState = vk::PipelineColorBlendAttachmentState{}
+		.setBlendEnable(VK_FALSE)
+		.setColorWriteMask(vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG | vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA); // write all color components
+
+	if (config.enableAlphaBlending) {
+		d.mColorBlendAttachmentState
+			.setBlendEnable(VK_TRUE)
+			.setSrcColorBlendFactor(vk::BlendFactor::eSrcAlpha)
+			.setDstColorBlendFactor(vk::BlendFactor::eOneMinusSrcAlpha)
+			.setColorBlendOp(vk::BlendOp::eAdd)
+			.setSrcAlphaBlendFactor(vk::BlendFactor::eSrcAlpha)
+			.setDstAlphaBlendFactor(vk::BlendFactor::eOneMinusSrcAlpha)
+			.setAlphaBlendOp(vk::BlendOp::eAdd);
+	}
+
+	d.mColorBlendState = vk::PipelineColorBlendStateCreateInfo{}.setAttachmentCount(1u).setPAttachments(&d.mColorBlendAttachmentState);
+	
+	// But again: not so fast! We have to define the LAYOUT of our descriptors first
+	d.mLayouts = getOrCreatePipelineLayouts(config);
+
+	// Put everything together:
+	d.mCreateInfo = vk::GraphicsPipelineCreateInfo{}
+		.setStageCount(static_cast<uint32_t>(d.mShaderStages.size())).setPStages(d.mShaderStages.data())
+		.setPVertexInputState(&d.mVertexInputState)
+		.setPInputAssemblyState(&d.mInputAssemblyState)
+		.setPViewportState(&d.mViewportState)
+		.setPRasterizationState(&d.mRasterizerState)
+		.setPMultisampleState(&d.mMultisampleState)
+		.setPDepthStencilState(&d.mDepthStencilState)
+		.setPColorBlendState(&d.mColorBlendState)
+		.setPDynamicState(d.mDynamicStates.empty() ? nullptr : &d.mDynamicState)
+		.setLayout(d.mLayouts->mPipelineLayout.get())
+		.setRenderPass(mRenderpass.get()).setSubpass(0u); // <--- Which subpass of the given renderpass we are going to use this graphics pipeline for
+}
+
+// Takes the created pipeline and the layouts out of the given description.
+VklPipelineObjects getGraphicsPipelineObjects(VklGraphicsPipelineDescription& description, vk::Pipeline graphicsPipeline)
+{
+	VklPipelineObjects objects;
+	objects.mPipeline = graphicsPipeline;
+	objects.mLayouts = std::move(description.mLayouts);
+	return objects;
+}
+
+// Graphics pipeline libraries (VK_EXT_graphics_pipeline_library): Pipelines are linked from four parts, each of which is
+// cached by a hash of the state it depends on. Pipelines which share parts (e.g., the same vertex shader and vertex input)
+// only need the differing parts to be created, and linking them without link-time optimization is fast.
+bool mGraphicsPipelineLibraryRequested = false;
+bool mGraphicsPipelineLibraryInUse = false;
+// A cached library, which is destroyed as soon as no pipeline that has been fast-linked from it (and is not optimized yet) is left:
+struct VklPipelineLibrary {
+	vk::Pipeline mLibrary;
+
+	VklPipelineLibrary(vk::Pipeline library) : mLibrary{ library } {}
+	VklPipelineLibrary(const VklPipelineLibrary&) = delete;
+	VklPipelineLibrary& operator=(const VklPipelineLibrary&) = delete;
+	~VklPipelineLibrary()
+	{
+		mDevice.destroyPipeline(mLibrary);
+	}
+};
+using VklPipelineLibraries = std::array<std::shared_ptr<VklPipelineLibrary>, 4>;
+std::mutex mPipelineLibrariesMutex; // Libraries are created on multiple threads concurrently
+std::unordered_map<uint64_t, std::weak_ptr<VklPipelineLibrary>> mPipelineLibraries;
+// The libraries which pipelines have been fast-linked from, so that they can be linked again with link-time optimization:
+std::unordered_map<VkPipeline, VklPipelineLibraries> mFastLinkedPipelines;
+// The libraries which the optimized versions of fast-linked pipelines have been linked from. Since both keep their libraries
+// alive until they are destroyed, hot-reloads of a pipeline (or new pipelines) only have to create the parts which differ:
+std::unordered_map<VkPipeline, VklPipelineLibraries> mOptimizedPipelineLibraries;
+
+// Returns true if the device supports VK_EXT_graphics_pipeline_library and its graphicsPipelineLibrary feature.
+bool isGraphicsPipelineLibrarySupported()
+{
+#ifdef VK_EXT_graphics_pipeline_library
+	const auto extensions = mPhysicalDevice.enumerateDeviceExtensionProperties();
+	const bool hasExtension = std::any_of(std::begin(extensions), std::end(extensions), [](const vk::ExtensionProperties& extension) {
+		return 0 == strcmp(extension.extensionName, VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+	});
+	if (!hasExtension || mPhysicalDevice.getProperties().apiVersion < VK_API_VERSION_1_1) {
+		return false;
+	}
+	auto features = mPhysicalDevice.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceGraphicsPipelineLibraryFeaturesEXT>();
+	return VK_TRUE == features.get<vk::PhysicalDeviceGraphicsPipelineLibraryFeaturesEXT>().graphicsPipelineLibrary;
+#else
+	return false;
+#endif
+}
+
+#ifdef VK_EXT_graphics_pipeline_library
+// Returns the library for the given part and key from the cache, or creates it from the given create info.
+std::shared_ptr<VklPipelineLibrary> getOrCreatePipelineLibrary(uint64_t key, vk::GraphicsPipelineLibraryFlagBitsEXT part, vk::GraphicsPipelineCreateInfo createInfo)
+{
+	{
+		std::lock_guard<std::mutex> lock(mPipelineLibrariesMutex);
+		auto it = mPipelineLibraries.find(key);
+		if (mPipelineLibraries.end() != it) {
+			if (auto library = it->second.lock()) {
+				return library;
+			}
+			mPipelineLibraries.erase(it); // => All pipelines linked from it have been destroyed
+		}
+	}
+
+	// Create the library without holding the lock, so that other threads can create other libraries in the meantime:
+	auto libraryCreateInfo = vk::GraphicsPipelineLibraryCreateInfoEXT{}.setFlags(part);
+	createInfo
+		.setPNext(&libraryCreateInfo)
+		.setFlags(vk::PipelineCreateFlagBits::eLibraryKHR | vk::PipelineCreateFlagBits::eRetainLinkTimeOptimizationInfoEXT);
+	auto library = std::make_shared<VklPipelineLibrary>(createGraphicsPipelinesFromModulesOrIdentifiers({ createInfo }).front());
+
+	std::lock_guard<std::mutex> lock(mPipelineLibrariesMutex);
+	auto& cached = mPipelineLibraries[key];
+	if (auto other = cached.lock()) {
+		// Another thread has created the same library in the meantime => ours is destroyed when returning:
+		return other;
+	}
+	cached = library;
+	return library;
+}
+#endif
+
+// Links a graphics pipeline from the given libraries, either fast or with link-time optimization.
+vk::Pipeline linkPipelineLibraries(const VklPipelineLibraries& libraries, vk::PipelineLayout pipelineLayout, bool linkTimeOptimization)
+{
+#ifdef VK_EXT_graphics_pipeline_library
+	std::array<vk::Pipeline, 4> libraryHandles;
+	std::transform(std::begin(libraries), std::end(libraries), std::begin(libraryHandles), [](const std::shared_ptr<VklPipelineLibrary>& library) { return library->mLibrary; });
+	auto libraryCreateInfo = vk::PipelineLibraryCreateInfoKHR{}
+		.setLibraryCount(static_cast<uint32_t>(libraryHandles.size())).setPLibraries(libraryHandles.data());
+	auto createInfo = vk::GraphicsPipelineCreateInfo{}
+		.setPNext(&libraryCreateInfo)
+		.setFlags(linkTimeOptimization ? vk::PipelineCreateFlagBits::eLinkTimeOptimizationEXT : vk::PipelineCreateFlags{})
+		.setLayout(pipelineLayout);
+	return createGraphicsPipelinesWithFeedback({ createInfo }).front();
+#else
+	VKL_EXIT_WITH_ERROR("Vulkan Launchpad has been built with Vulkan headers which do not support VK_EXT_graphics_pipeline_library.");
+#endif
+}
+
+// Creates (or gets from the cache) the four libraries of the described pipeline, and fast-links them.
+vk::Pipeline linkGraphicsPipelineFromLibraries(const VklGraphicsPipelineDescription& d, const VklGraphicsPipelineConfig& config, const std::vector<uint32_t>& vertexSpirv, const std::vector<uint32_t>& fragmentSpirv)
+{
+	VklPipelineLibraries libraries;
+#ifdef VK_EXT_graphics_pipeline_library
+	const uint64_t layoutKey = computePipelineLayoutKey(config);
+
+	// Vertex input interface: vertex input and input assembly state
+	uint64_t key = hashString("vertex input interface");
+	key = hashBytes(config.vertexInputBuffers.data(), config.vertexInputBuffers.size() * sizeof(VkVertexInputBindingDescription), key);
+	key = hashBytes(config.inputAttributeDescriptions.data(), config.inputAttributeDescriptions.size() * sizeof(VkVertexInputAttributeDescription), key);
+	libraries[0] = getOrCreatePipelineLibrary(key, vk::GraphicsPipelineLibraryFlagBitsEXT::eVertexInputInterface, vk::GraphicsPipelineCreateInfo{}
+		.setPVertexInputState(&d.mVertexInputState)
+		.setPInputAssemblyState(&d.mInputAssemblyState));
+
+	// Pre-rasterization shaders: vertex shader, viewport, and rasterization state
+	const int preRasterizationState[] = { static_cast<int>(config.polygonDrawMode), static_cast<int>(config.triangleCullingMode), config.dynamicViewportAndScissor ? 1 : 0,
+		config.dynamicViewportAndScissor ? 0 : static_cast<int>(mSwapchainConfig.imageExtent.width), config.dynamicViewportAndScissor ? 0 : static_cast<int>(mSwapchainConfig.imageExtent.height) };
+	key = hashString("pre-rasterization shaders", layoutKey);
+	key = hashBytes(vertexSpirv.data(), vertexSpirv.size() * sizeof(uint32_t), key);
+	key = hashSpecializationConstants(config.vertexShaderSpecializationConstants, key);
+	key = hashBytes(preRasterizationState, sizeof(preRasterizationState), key);
+	libraries[1] = getOrCreatePipelineLibrary(key, vk::GraphicsPipelineLibraryFlagBitsEXT::ePreRasterizationShaders, vk::GraphicsPipelineCreateInfo{}
+		.setStageCount(1u).setPStages(&d.mShaderStages[0])
+		.setPViewportState(&d.mViewportState)
+		.setPRasterizationState(&d.mRasterizerState)
+		.setPDynamicState(d.mDynamicStates.empty() ? nullptr : &d.mDynamicState)
+		.setLayout(d.mLayouts->mPipelineLayout.get())
+		.setRenderPass(mRenderpass.get()).setSubpass(0u));
+
+	// Fragment shader: fragment shader, depth/stencil, and multisample state
+	key = hashString("fragment shader", layoutKey);
+	key = hashBytes(fragmentSpirv.data(), fragmentSpirv.size() * sizeof(uint32_t), key);
+	key = hashSpecializationConstants(config.fragmentShaderSpecializationConstants, key);
+	libraries[2] = getOrCreatePipelineLibrary(key, vk::GraphicsPipelineLibraryFlagBitsEXT::eFragmentShader, vk::GraphicsPipelineCreateInfo{}
+		.setStageCount(1u).setPStages(&d.mShaderStages[1])
+		.setPDepthStencilState(&d.mDepthStencilState)
+		.setPMultisampleState(&d.mMultisampleState)
+		.setLayout(d.mLayouts->mPipelineLayout.get())
+		.setRenderPass(mRenderpass.get()).setSubpass(0u));
+
+	// Fragment output interface: color blend and multisample state
+	key = hashString("fragment output interface");
+	key = hashBytes(&config.enableAlphaBlending, sizeof(config.enableAlphaBlending), key);
+	libraries[3] = getOrCreatePipelineLibrary(key, vk::GraphicsPipelineLibraryFlagBitsEXT::eFragmentOutputInterface, vk::GraphicsPipelineCreateInfo{}
+		.setPColorBlendState(&d.mColorBlendState)
+		.setPMultisampleState(&d.mMultisampleState)
+		.setRenderPass(mRenderpass.get()).setSubpass(0u));
+#endif
+
+	auto graphicsPipeline = linkPipelineLibraries(libraries, d.mLayouts->mPipelineLayout.get(), /* link-time optimization: */ false);
+	std::lock_guard<std::mutex> lock(mPipelineLibrariesMutex);
+	mFastLinkedPipelines[static_cast<VkPipeline>(graphicsPipeline)] = std::move(libraries);
+	return graphicsPipeline;
+}
+
+// Destroys a pipeline which has never been registered (see registerPipeline), and releases the libraries it has been linked from.
+void destroyUnregisteredPipeline(vk::Pipeline pipeline)
+{
+	mDevice.destroyPipeline(pipeline);
+	std::lock_guard<std::mutex> lock(mPipelineLibrariesMutex);
+	mFastLinkedPipelines.erase(static_cast<VkPipeline>(pipeline));
+	mOptimizedPipelineLibraries.erase(static_cast<VkPipeline>(pipeline));
+}
+
+// Hashes the SPIR-V of all stages of a pipeline, to find out whether hot-reloading its shaders has changed anything.
+uint64_t hashPipelineSpirv(const VklCachedShaderModule& vertex, const VklCachedShaderModule& fragment)
+{
+	const auto& v = vertex.mShader.mSpirv;
+	const auto& f = fragment.mShader.mSpirv;
+	return hashBytes(f.data(), f.size() * sizeof(uint32_t), hashBytes(v.data(), v.size() * sizeof(uint32_t)));
+}
+
+// Creates a graphics pipeline from the given shader modules. If graphics pipeline libraries are in use, it is fast-linked from them.
+// It does not touch any of the framework's bookkeeping data structures, so that it can be invoked from worker threads.
+VklPipelineObjects buildGraphicsPipelineFromShaderModules(const VklGraphicsPipelineConfig& config, const VklCachedShaderModule& vertex, const VklCachedShaderModule& fragment)
+{
+	VklGraphicsPipelineDescription description;
+	describeGraphicsPipeline(description, config, getShaderStageCreateInfo(vertex), getShaderStageCreateInfo(fragment));
+	// FINALLY:
+	auto graphicsPipeline = mGraphicsPipelineLibraryInUse
+		? linkGraphicsPipelineFromLibraries(description, config, vertex.mShader.mSpirv, fragment.mShader.mSpirv)
+		: createGraphicsPipelinesFromModulesOrIdentifiers({ description.mCreateInfo }).front();
+	// The shader modules stay in the shader module cache, so that other pipelines using the same shaders do not have to recreate them.
+	auto objects = getGraphicsPipelineObjects(description, graphicsPipeline);
+	objects.mSpirvHash = hashPipelineSpirv(vertex, fragment);
+	return objects;
+}
+
+// Takes over the bookkeeping of the given pipeline objects and returns the pipeline's handle.
+VkPipeline registerPipeline(VklPipelineObjects&& objects)
+{
+	auto graphicsPipelineHandle = static_cast<VkPipeline>(objects.mPipeline);
+	mPipelineLayouts[graphicsPipelineHandle] = std::move(objects.mLayouts);
+	if (0 != objects.mSpirvHash) {
+		mPipelineSpirvHashes[graphicsPipelineHandle] = objects.mSpirvHash;
+	}
+	return graphicsPipelineHandle;
+}
+
+// A hot-reload of a graphics pipeline whose shaders are being compiled on the worker threads:
+struct VklPendingPipelineReload {
+	VkPipeline mOriginalHandle;
+	std::future<VklPipelineObjects> mPipelineObjects;
+};
+std::deque<VklPendingPipelineReload> mPendingPipelineReloads;
+std::chrono::steady_clock::time_point mPipelineReloadStartTime;
+size_t mNumPipelinesInReload = 0;
+size_t mNumUnchangedPipelinesInReload = 0; // Those which have been kept, because their SPIR-V has not changed
+
+// Graphics pipelines which are being created on the worker threads via vklCreateGraphicsPipelineAsync, by their slot handles.
+// Until a pipeline is ready, its slot's fallback pipeline is bound instead (or nothing at all, if that is VK_NULL_HANDLE).
+// The futures are not valid anymore if the creation has failed.
+std::unordered_map<VkPipeline, std::future<VklPipelineObjects>> mPendingPipelineCreations;
+// Pipelines which have been destroyed by the user while they were still being created. They are destroyed as soon as they are ready:
+std::vector<std::future<VklPipelineObjects>> mAbandonedPipelineCreations;
+
+// A pipeline which has been fast-linked from graphics pipeline libraries, and which is being linked with link-time optimization on the worker threads:
+struct VklPendingPipelineOptimization {
+	VkPipeline mOriginalHandle;
+	VkPipeline mFastLinkedHandle;
+	std::future<VklPipelineObjects> mPipelineObjects;
+	VklPipelineLibraries mLibraries; // Handed over to the optimized pipeline once it is swapped in
+};
+std::deque<VklPendingPipelineOptimization> mPendingPipelineOptimizations;
+
+// Defined further below:
+void pollShaderFileWatcher();
+void closeShaderFileWatcher();
+// Destroys an actual pipeline (i.e., not a slot handle), defined further below:
+void destroyPipelineInternal(VkPipeline pipeline);
+// Invoked at frame boundaries and in vklDestroyFramework, defined further below:
+void applyFinishedPipelineCreations(bool waitForAll);
+void applyFinishedPipelineOptimizations(bool waitForAll);
+
+// If the pipeline which the given handle currently resolves to has been fast-linked from libraries,
+// it is linked again with link-time optimization on the worker threads, and swapped in once that is done.
+void scheduleLinkTimeOptimization(VkPipeline originalHandle)
+{
+	const auto fastLinkedHandle = resolvePipelineHandle(originalHandle);
+	VklPipelineLibraries libraries;
+	{
+		std::lock_guard<std::mutex> lock(mPipelineLibrariesMutex);
+		auto it = mFastLinkedPipelines.find(fastLinkedHandle);
+		if (mFastLinkedPipelines.end() == it) {
+			return;
+		}
+		libraries = std::move(it->second);
+		mFastLinkedPipelines.erase(it);
+	}
+
+	auto config = std::get<0>(mUserKnownPipelines.at(originalHandle));
+	config.vertexShaderPath = nullptr;
+	config.fragmentShaderPath = nullptr;
+	auto spirvHash = mPipelineSpirvHashes.find(fastLinkedHandle);
+	auto pipelineFuture = submitWorkerJob([config, libraries, spirvHash = mPipelineSpirvHashes.end() != spirvHash ? spirvHash->second : 0]() {
+		VklPipelineObjects objects;
+		objects.mLayouts = getOrCreatePipelineLayouts(config);
+		objects.mPipeline = linkPipelineLibraries(libraries, objects.mLayouts->mPipelineLayout.get(), /* link-time optimization: */ true);
+		objects.mSpirvHash = spirvHash; // Linked from the same shaders
+		return objects;
+	});
+	mPendingPipelineOptimizations.push_back(VklPendingPipelineOptimization{ originalHandle, fastLinkedHandle, std::move(pipelineFuture), std::move(libraries) });
+}
+
+// Compiles all stages from the given (already loaded) shader sources and creates the pipeline on the worker threads. Sources of precompiled stages are ignored.
+// The files the shaders have been compiled from are returned along with the pipeline objects, even if compilation failed.
+// If the SPIR-V of all stages hashes to currentSpirvHash, no pipeline is created, and mSpirvUnchanged is set instead.
+std::future<VklPipelineObjects> createGraphicsPipelineFromSourcesOnWorkerThreads(VklGraphicsPipelineConfig config, VklShaderSource vertexSource, VklShaderSource fragmentSource, uint64_t currentSpirvHash = 0)
+{
+	auto vertexModule = nullptr != config.vertexShaderSpirv
+		? getOrCreatePrecompiledShaderModule(config.vertexShaderSpirv, config.vertexShaderSpirvSizeInBytes, vk::ShaderStageFlagBits::eVertex)
+		: getOrCompileShaderModule(std::move(vertexSource), config.shaderCompileOptions, vk::ShaderStageFlagBits::eVertex, /* on worker thread: */ true);
+	auto fragmentModule = nullptr != config.fragmentShaderSpirv
+		? getOrCreatePrecompiledShaderModule(config.fragmentShaderSpirv, config.fragmentShaderSpirvSizeInBytes, vk::ShaderStageFlagBits::eFragment)
+		: getOrCompileShaderModule(std::move(fragmentSource), config.shaderCompileOptions, vk::ShaderStageFlagBits::eFragment, /* on worker thread: */ true);
+
+	// The pipeline job is enqueued after its compilation jobs (or those of earlier requests for the same shaders). Since jobs are
+	// dequeued in FIFO order, the compilation jobs have already been picked up by the time this job waits on them, which rules out deadlocks.
+	config.vertexShaderPath = nullptr;
+	config.fragmentShaderPath = nullptr;
+	return submitWorkerJob([config, vertexModule, fragmentModule, currentSpirvHash]() {
+		const auto& vertex = *vertexModule.get();
+		const auto& fragment = *fragmentModule.get();
+		VklPipelineObjects objects;
+		if (vertex.mModule && fragment.mModule) {
+			if (0 != currentSpirvHash && hashPipelineSpirv(vertex, fragment) == currentSpirvHash) {
+				objects.mSpirvUnchanged = true; // => e.g., only comments or whitespace have changed
+			}
+			else {
+				objects = buildGraphicsPipelineFromShaderModules(config, vertex, fragment);
+			}
+		}
+		objects.mShaderFiles = vertex.mShader.mFiles;
+		appendShaderFiles(objects.mShaderFiles, fragment.mShader.mFiles);
+		return objects;
+	});
+}
+
+// Reads the shader files on this thread, then compiles all stages and creates the pipeline on the worker threads.
+std::future<VklPipelineObjects> createGraphicsPipelineOnWorkerThreads(VklGraphicsPipelineConfig config, const char* vertexShaderPathOrCode, const char* fragmentShaderPathOrCode, bool loadFromMemory, uint64_t currentSpirvHash = 0)
+{
+	auto vertexSource   = nullptr != config.vertexShaderSpirv   ? VklShaderSource{} : loadShaderSource(vertexShaderPathOrCode,   loadFromMemory, "vertex");
+	auto fragmentSource = nullptr != config.fragmentShaderSpirv ? VklShaderSource{} : loadShaderSource(fragmentShaderPathOrCode, loadFromMemory, "fragment");
+	return createGraphicsPipelineFromSourcesOnWorkerThreads(std::move(config), std::move(vertexSource), std::move(fragmentSource), currentSpirvHash);
+}
+
+// Returns the (cached) shader module of the given compute pipeline config, which is either precompiled or compiled from the given path or code.
+VklShaderModuleFuture getComputeShaderModule(const VklComputePipelineConfig& config, const char* computeShaderPathOrCode, bool loadFromMemory, bool onWorkerThread)
+{
+	return nullptr != config.computeShaderSpirv
+		? getOrCreatePrecompiledShaderModule(config.computeShaderSpirv, config.computeShaderSpirvSizeInBytes, vk::ShaderStageFlagBits::eCompute)
+		: getOrCompileShaderModule(loadShaderSource(computeShaderPathOrCode, loadFromMemory, "compute"), config.shaderCompileOptions, vk::ShaderStageFlagBits::eCompute, onWorkerThread);
+}
+
+uint64_t hashPipelineSpirv(const VklCachedShaderModule& compute)
+{
+	const auto& c = compute.mShader.mSpirv;
+	return hashBytes(c.data(), c.size() * sizeof(uint32_t));
+}
+
+// Creates a compute pipeline from the given shader module. Just like buildGraphicsPipelineFromShaderModules, it can be invoked from worker threads.
+VklPipelineObjects buildComputePipelineFromShaderModule(const VklComputePipelineConfig& config, const VklCachedShaderModule& compute)
+{
+	auto stage = getShaderStageCreateInfo(compute);
+	std::vector<vk::SpecializationMapEntry> specializationMapEntries;
+	std::vector<uint32_t> specializationData;
+	vk::SpecializationInfo specializationInfo;
+	describeSpecialization(stage, config.computeShaderSpecializationConstants, specializationMapEntries, specializationData, specializationInfo);
+
+	VklPipelineObjects objects;
+	objects.mLayouts = getOrCreatePipelineLayouts(config);
+	objects.mPipeline = mDevice.createComputePipeline(mPipelineCache, vk::ComputePipelineCreateInfo{}
+		.setStage(stage)
+		.setLayout(objects.mLayouts->mPipelineLayout.get())
+	).value;
+	objects.mSpirvHash = hashPipelineSpirv(compute);
+	return objects;
+}
+
+// Compiles the compute shader and creates the compute pipeline on the worker threads, like createGraphicsPipelineOnWorkerThreads.
+std::future<VklPipelineObjects> createComputePipelineOnWorkerThreads(VklComputePipelineConfig config, const char* computeShaderPathOrCode, bool loadFromMemory, uint64_t currentSpirvHash = 0)
+{
+	auto computeModule = getComputeShaderModule(config, computeShaderPathOrCode, loadFromMemory, /* on worker thread: */ true);
+	config.computeShaderPath = nullptr;
+	return submitWorkerJob([config, computeModule, currentSpirvHash]() {
+		const auto& compute = *computeModule.get();
+		VklPipelineObjects objects;
+		if (compute.mModule) {
+			if (0 != currentSpirvHash && hashPipelineSpirv(compute) == currentSpirvHash) {
+				objects.mSpirvUnchanged = true;
+			}
+			else {
+				objects = buildComputePipelineFromShaderModule(config, compute);
+			}
+		}
+		objects.mShaderFiles = compute.mShader.mFiles;
+		return objects;
+	});
+}
+
+// Pipelines created via vklCreateGraphicsPipeline are shared between identical configs:
+std::unordered_map<uint64_t, VkPipeline> mPipelinesByConfigKey;
+// The number of vklCreateGraphicsPipeline calls that returned a shared pipeline handle, and the key of its config:
+std::unordered_map<VkPipeline, std::tuple<uint64_t, uint32_t>> mPipelineReferences;
+
+// Loads the GLSL code of both shader stages, except for stages which have been precompiled (their source stays empty).
+std::tuple<VklShaderSource, VklShaderSource> loadGraphicsPipelineShaderSources(const VklGraphicsPipelineConfig& config, bool loadShadersFromMemoryInstead)
+{
+	return std::make_tuple(
+		nullptr != config.vertexShaderSpirv   ? VklShaderSource{} : loadShaderSource(config.vertexShaderPath,   loadShadersFromMemoryInstead, "vertex"),
+		nullptr != config.fragmentShaderSpirv ? VklShaderSource{} : loadShaderSource(config.fragmentShaderPath, loadShadersFromMemoryInstead, "fragment")
+	);
+}
+
+// Hashes everything which a graphics pipeline depends on, i.e., the whole config including the contents of its shaders.
+uint64_t computeGraphicsPipelineConfigKey(const VklGraphicsPipelineConfig& config, const VklShaderSource& vertexSource, const VklShaderSource& fragmentSource)
+{
+	uint64_t key = hashBytes(config.vertexInputBuffers.data(), config.vertexInputBuffers.size() * sizeof(VkVertexInputBindingDescription));
+	key = hashBytes(config.inputAttributeDescriptions.data(), config.inputAttributeDescriptions.size() * sizeof(VkVertexInputAttributeDescription), key);
+	const auto layoutKey = computePipelineLayoutKey(config);
+	key = hashBytes(&layoutKey, sizeof(layoutKey), key);
+	const int state[] = { static_cast<int>(config.polygonDrawMode), static_cast<int>(config.triangleCullingMode), config.enableAlphaBlending ? 1 : 0, config.dynamicViewportAndScissor ? 1 : 0 };
+	key = hashBytes(state, sizeof(state), key);
+	key = hashShaderCompileOptions(config.shaderCompileOptions, key);
+	key = hashSpecializationConstants(config.vertexShaderSpecializationConstants, key);
+	key = hashSpecializationConstants(config.fragmentShaderSpecializationConstants, key);
+	const auto hashStage = [&key](const uint32_t* spirv, size_t spirvSizeInBytes, const VklShaderSource& source) {
+		if (nullptr != spirv) {
+			key = hashBytes(spirv, spirvSizeInBytes, key);
+			return;
+		}
+		// The name (i.e., the path) is hashed, too, so that hot-reloading a shared pipeline reloads the files of all of its users:
+		key = hashString(source.mName, key);
+		key = hashString(source.mCode, key);
+		key = hashString(source.mIncludeBaseDirectory, key);
+	};
+	hashStage(config.vertexShaderSpirv,   config.vertexShaderSpirvSizeInBytes,   vertexSource);
+	hashStage(config.fragmentShaderSpirv, config.fragmentShaderSpirvSizeInBytes, fragmentSource);
+	return key;
+}
+
+// Creates a graphics pipeline from the already loaded shader sources, and optionally returns all files its shaders have been compiled from.
+VkPipeline createGraphicsPipelineFromSources(const VklGraphicsPipelineConfig& config, VklShaderSource vertexSource, VklShaderSource fragmentSource, std::vector<VklShaderFileDependency>* out_shaderFiles)
+{
+	// Compile both stages at the same time (unless they are in the shader module cache): the fragment shader on a worker thread, the vertex shader on this thread:
+	auto fragmentModule = nullptr != config.fragmentShaderSpirv
+		? getOrCreatePrecompiledShaderModule(config.fragmentShaderSpirv, config.fragmentShaderSpirvSizeInBytes, vk::ShaderStageFlagBits::eFragment)
+		: getOrCompileShaderModule(std::move(fragmentSource), config.shaderCompileOptions, vk::ShaderStageFlagBits::eFragment, /* on worker thread: */ true);
+	auto vertexModule = nullptr != config.vertexShaderSpirv
+		? getOrCreatePrecompiledShaderModule(config.vertexShaderSpirv, config.vertexShaderSpirvSizeInBytes, vk::ShaderStageFlagBits::eVertex)
+		: getOrCompileShaderModule(std::move(vertexSource), config.shaderCompileOptions, vk::ShaderStageFlagBits::eVertex, /* on worker thread: */ false);
+	const auto& vertex = *vertexModule.get();
+	const auto& fragment = *fragmentModule.get();
+
+	if (!vertex.mModule || !fragment.mModule) {
+		return VK_NULL_HANDLE;
+	}
+
+	if (nullptr != out_shaderFiles) {
+		*out_shaderFiles = vertex.mShader.mFiles;
+		appendShaderFiles(*out_shaderFiles, fragment.mShader.mFiles);
+	}
+	return registerPipeline(buildGraphicsPipelineFromShaderModules(config, vertex, fragment));
+}
+
+// Creates a graphics pipeline, and optionally returns all files its shaders have been compiled from.
+VkPipeline createGraphicsPipelineInternal(const VklGraphicsPipelineConfig& config, bool loadShadersFromMemoryInstead, std::vector<VklShaderFileDependency>* out_shaderFiles = nullptr)
+{
+    if (!loadShadersFromMemoryInstead && !vklFrameworkInitialized()) {
+        VKL_EXIT_WITH_ERROR("Framework not initialized. Ensure to invoke vklInitFramework beforehand!");
+    }
+	auto [vertexSource, fragmentSource] = loadGraphicsPipelineShaderSources(config, loadShadersFromMemoryInstead);
+	return createGraphicsPipelineFromSources(config, std::move(vertexSource), std::move(fragmentSource), out_shaderFiles);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Pipeline manifests: configs of pipelines recorded in one session, which are prewarmed in the next
+
+constexpr uint32_t PIPELINE_MANIFEST_FORMAT_VERSION = 1u;
+constexpr uint32_t PIPELINE_MANIFEST_MAGIC = 0x4D4C4B56u; // "VKLM"
+
+// Precedes the entries of a pipeline manifest file. Every entry consists of <uint64_t size, serialized config>.
+struct VklPipelineManifestHeader {
+	uint32_t magic;
+	uint32_t formatVersion;
+	uint64_t numEntries;
+};
+
+// A graphics pipeline config which has been read from a pipeline manifest. It owns the shader paths (or code) which the config points to.
+struct VklPipelineManifestEntry {
+	VklGraphicsPipelineConfig mConfig; // Its shader paths are set to mVertexShader and mFragmentShader when it is used
+	std::string mVertexShader;
+	std::string mFragmentShader;
+	bool mLoadShadersFromMemory = false;
+	uint64_t mVertexShaderContentHash = 0;
+	uint64_t mFragmentShaderContentHash = 0;
+};
+
+std::string mPipelineManifestRecordingPath; // Empty if not recording
+std::vector<std::string> mRecordedPipelineManifestEntries;
+std::unordered_set<uint64_t> mRecordedPipelineManifestEntryHashes;
+// Pipelines which are being created from a manifest by their config key, until a matching vklCreateGraphicsPipeline call takes them over:
+std::unordered_map<uint64_t, std::future<VklPipelineObjects>> mPrewarmedPipelines;
+
+template <typename T>
+void appendToManifestEntry(std::string& entry, const T& value)
+{
+	static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be stored in pipeline manifests.");
+	entry.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void appendToManifestEntry(std::string& entry, const std::string& value)
+{
+	appendToManifestEntry(entry, static_cast<uint64_t>(value.size()));
+	entry.append(value);
+}
+
+template <typename T>
+void appendToManifestEntry(std::string& entry, const std::vector<T>& values)
+{
+	appendToManifestEntry(entry, static_cast<uint64_t>(values.size()));
+	for (const auto& value : values) {
+		appendToManifestEntry(entry, value);
+	}
+}
+
+// Reads the values of a pipeline manifest entry in the order in which they have been appended. mFailed is set if the entry is too short.
+struct VklManifestEntryReader {
+	const std::string& mEntry;
+	size_t mOffset = 0;
+	bool mFailed = false;
+
+	template <typename T>
+	void read(T& out_value)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be stored in pipeline manifests.");
+		if (mFailed || mEntry.size() - mOffset < sizeof(T)) {
+			mFailed = true;
+			return;
+		}
+		memcpy(&out_value, mEntry.data() + mOffset, sizeof(T));
+		mOffset += sizeof(T);
+	}
+
+	void read(std::string& out_value)
+	{
+		uint64_t size = 0;
+		read(size);
+		if (mFailed || mEntry.size() - mOffset < size) {
+			mFailed = true;
+			return;
+		}
+		out_value.assign(mEntry.data() + mOffset, static_cast<size_t>(size));
+		mOffset += static_cast<size_t>(size);
+	}
+
+	template <typename T>
+	void read(std::vector<T>& out_values)
+	{
+		uint64_t size = 0;
+		read(size);
+		if (mFailed || size > mEntry.size() - mOffset) { // Every value takes at least one byte
+			mFailed = true;
+			return;
+		}
+		out_values.resize(static_cast<size_t>(size));
+		for (auto& value : out_values) {
+			read(value);
+		}
+	}
+};
+
+// Serializes everything which is required to create the given pipeline again, including the content hashes of its shaders.
+// Returns an empty string for pipelines which can not be recreated from a manifest, i.e., those with precompiled shaders or immutable samplers.
+std::string serializePipelineManifestEntry(const VklGraphicsPipelineConfig& config, bool loadShadersFromMemory)
+{
+	if (nullptr != config.vertexShaderSpirv || nullptr != config.fragmentShaderSpirv || nullptr == config.vertexShaderPath || nullptr == config.fragmentShaderPath
+		|| std::any_of(std::begin(config.descriptorLayout), std::end(config.descriptorLayout), [](const VkDescriptorSetLayoutBinding& binding) { return nullptr != binding.pImmutableSamplers; })) {
+		return std::string{};
+	}
+	const auto hashShader = [loadShadersFromMemory](const char* shaderPathOrCode) -> uint64_t {
+		if (loadShadersFromMemory) {
+			return hashString(shaderPathOrCode);
+		}
+		std::string content;
+		VklShaderFileDependency file;
+		return readShaderFile(shaderPathOrCode, content, file) ? file.mContentHash : 0;
+	};
+
+	std::string entry;
+	appendToManifestEntry(entry, loadShadersFromMemory);
+	appendToManifestEntry(entry, std::string(config.vertexShaderPath));
+	appendToManifestEntry(entry, std::string(config.fragmentShaderPath));
+	appendToManifestEntry(entry, hashShader(config.vertexShaderPath));
+	appendToManifestEntry(entry, hashShader(config.fragmentShaderPath));
+	appendToManifestEntry(entry, config.vertexInputBuffers);
+	appendToManifestEntry(entry, config.inputAttributeDescriptions);
+	appendToManifestEntry(entry, config.polygonDrawMode);
+	appendToManifestEntry(entry, config.triangleCullingMode);
+	appendToManifestEntry(entry, static_cast<uint64_t>(config.descriptorLayout.size()));
+	for (const auto& binding : config.descriptorLayout) {
+		const uint32_t values[] = { binding.binding, static_cast<uint32_t>(binding.descriptorType), binding.descriptorCount, binding.stageFlags };
+		appendToManifestEntry(entry, values);
+	}
+	appendToManifestEntry(entry, config.pushConstantRanges);
+	appendToManifestEntry(entry, config.enableAlphaBlending);
+	appendToManifestEntry(entry, config.dynamicViewportAndScissor);
+	appendToManifestEntry(entry, config.shaderCompileOptions.macroDefinitions);
+	appendToManifestEntry(entry, config.shaderCompileOptions.targetVulkanVersion);
+	appendToManifestEntry(entry, config.shaderCompileOptions.optimizationLevel);
+	appendToManifestEntry(entry, config.shaderCompileOptions.generateDebugInfo);
+	appendToManifestEntry(entry, config.shaderCompileOptions.stripDebugInfo);
+	appendToManifestEntry(entry, config.vertexShaderSpecializationConstants);
+	appendToManifestEntry(entry, config.fragmentShaderSpecializationConstants);
+	return entry;
+}
+
+// The counterpart of serializePipelineManifestEntry. Returns false if the entry is malformed.
+bool parsePipelineManifestEntry(const std::string& data, VklPipelineManifestEntry& out_entry)
+{
+	VklManifestEntryReader reader{ data };
+	auto& config = out_entry.mConfig;
+	reader.read(out_entry.mLoadShadersFromMemory);
+	reader.read(out_entry.mVertexShader);
+	reader.read(out_entry.mFragmentShader);
+	reader.read(out_entry.mVertexShaderContentHash);
+	reader.read(out_entry.mFragmentShaderContentHash);
+	reader.read(config.vertexInputBuffers);
+	reader.read(config.inputAttributeDescriptions);
+	reader.read(config.polygonDrawMode);
+	reader.read(config.triangleCullingMode);
+	uint64_t numBindings = 0;
+	reader.read(numBindings);
+	for (uint64_t i = 0; i < numBindings && !reader.mFailed; ++i) {
+		uint32_t values[4] = {};
+		reader.read(values);
+		config.descriptorLayout.push_back(VkDescriptorSetLayoutBinding{ values[0], static_cast<VkDescriptorType>(values[1]), values[2], values[3], nullptr });
+	}
+	reader.read(config.pushConstantRanges);
+	reader.read(config.enableAlphaBlending);
+	reader.read(config.dynamicViewportAndScissor);
+	reader.read(config.shaderCompileOptions.macroDefinitions);
+	reader.read(config.shaderCompileOptions.targetVulkanVersion);
+	reader.read(config.shaderCompileOptions.optimizationLevel);
+	reader.read(config.shaderCompileOptions.generateDebugInfo);
+	reader.read(config.shaderCompileOptions.stripDebugInfo);
+	reader.read(config.vertexShaderSpecializationConstants);
+	reader.read(config.fragmentShaderSpecializationConstants);
+	return !reader.mFailed && reader.mOffset == data.size();
+}
+
+// Adds the given pipeline to the manifest which is being recorded, unless it has been recorded before.
+void recordPipelineInManifest(const VklGraphicsPipelineConfig& config, bool loadShadersFromMemory)
+{
+	if (mPipelineManifestRecordingPath.empty()) {
+		return;
+	}
+	auto entry = serializePipelineManifestEntry(config, loadShadersFromMemory);
+	if (entry.empty() || !mRecordedPipelineManifestEntryHashes.insert(hashString(entry)).second) {
+		return;
+	}
+	mRecordedPipelineManifestEntries.push_back(std::move(entry));
+}
+
+// Writes all recorded pipelines to the manifest file.
+void savePipelineManifest()
+{
+	if (mPipelineManifestRecordingPath.empty()) {
+		return;
+	}
+	const std::filesystem::path path = mPipelineManifestRecordingPath;
+	std::error_code ec;
+	if (path.has_parent_path()) {
+		std::filesystem::create_directories(path.parent_path(), ec);
+	}
+	// Write to a temporary file first, so that a crash never leaves a partially written manifest behind:
+	auto tmpPath = path;
+	tmpPath += ".tmp";
+	{
+		std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+		const VklPipelineManifestHeader header = { PIPELINE_MANIFEST_MAGIC, PIPELINE_MANIFEST_FORMAT_VERSION, static_cast<uint64_t>(mRecordedPipelineManifestEntries.size()) };
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		for (const auto& entry : mRecordedPipelineManifestEntries) {
+			const uint64_t size = entry.size();
+			file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+			file.write(entry.data(), static_cast<std::streamsize>(entry.size()));
+		}
+		if (!file.good()) {
+			VKL_WARNING("Unable to write pipeline manifest[" << tmpPath.string() << "]");
+			return;
+		}
+	}
+	std::filesystem::rename(tmpPath, path, ec);
+	if (ec) {
+		VKL_WARNING("Unable to write pipeline manifest[" << path.string() << "]: " << ec.message());
+		std::filesystem::remove(tmpPath, ec);
+		return;
+	}
+	VKL_LOG("Recorded " << mRecordedPipelineManifestEntries.size() << " graphics pipelines in pipeline manifest[" << path.string() << "].");
+}
+
+// Takes over the pipeline which has been prewarmed for the given config key, waiting for it if it is still being created.
+// Returns empty pipeline objects if there is no such pipeline, or if its creation has failed.
+VklPipelineObjects takePrewarmedPipeline(uint64_t configKey)
+{
+	VklPipelineObjects objects;
+	auto it = mPrewarmedPipelines.find(configKey);
+	if (mPrewarmedPipelines.end() == it) {
+		return objects;
+	}
+	try {
+		objects = it->second.get();
+	}
+	catch (const std::exception& e) {
+		VKL_WARNING("Prewarming a graphics pipeline failed: " << e.what());
+	}
+	mPrewarmedPipelines.erase(it);
+	return objects;
+}
+
+// Destroys all prewarmed pipelines which have never been requested.
+void destroyUnusedPrewarmedPipelines()
+{
+	while (!mPrewarmedPipelines.empty()) {
+		auto objects = takePrewarmedPipeline(std::begin(mPrewarmedPipelines)->first);
+		if (objects.mPipeline) {
+			destroyUnregisteredPipeline(objects.mPipeline);
+		}
+	}
+}
+
+void vklRecordPipelineManifest(const char* manifest_path)
+{
+	mPipelineManifestRecordingPath = nullptr != manifest_path ? manifest_path : "";
+	mRecordedPipelineManifestEntries.clear();
+	mRecordedPipelineManifestEntryHashes.clear();
+}
 
-	if (path.empty()) { // Fail if shader file could not be found:
-		VKL_EXIT_WITH_ERROR("Unable to load file[" << shader_filename << "].");
+uint32_t vklPrewarmPipelines(const char* manifest_path)
+{
+	if (!vklFrameworkInitialized()) {
+		VKL_EXIT_WITH_ERROR("Framework not initialized. Ensure to invoke vklInitFramework beforehand!");
+	}
+	std::ifstream file(manifest_path, std::ios::binary);
+	if (!file.good()) {
+		VKL_LOG("No pipeline manifest found at[" << manifest_path << "], nothing to prewarm.");
+		return 0;
+	}
+	VklPipelineManifestHeader header = {};
+	file.read(reinterpret_cast<char*>(&header), sizeof(header));
+	if (!file.good() || PIPELINE_MANIFEST_MAGIC != header.magic || PIPELINE_MANIFEST_FORMAT_VERSION != header.formatVersion) {
+		VKL_WARNING("Ignoring pipeline manifest[" << manifest_path << "], since it has been written by a different version of Vulkan Launchpad.");
+		return 0;
 	}
 
-	std::ifstream ifs(path);
-	std::string content(
-		(std::istreambuf_iterator<char>(ifs)),
-		(std::istreambuf_iterator<char>())
-	);
+	uint32_t numPrewarmed = 0;
+	uint32_t numChanged = 0;
+	for (uint64_t i = 0; i < header.numEntries; ++i) {
+		uint64_t size = 0;
+		file.read(reinterpret_cast<char*>(&size), sizeof(size));
+		if (!file.good() || size > (1ull << 24)) {
+			break;
+		}
+		std::string data(static_cast<size_t>(size), '\0');
+		file.read(data.data(), static_cast<std::streamsize>(size));
+		VklPipelineManifestEntry entry;
+		if (!file.good() || !parsePipelineManifestEntry(data, entry)) {
+			VKL_WARNING("Pipeline manifest[" << manifest_path << "] is corrupt, only " << i << " of its entries are prewarmed.");
+			break;
+		}
 
-	return loadShaderFromMemoryAndCreateShaderModuleAndStageInfo(content, path, shaderStage);
+		auto config = entry.mConfig;
+		config.vertexShaderPath = entry.mVertexShader.c_str();
+		config.fragmentShaderPath = entry.mFragmentShader.c_str();
+		if (!entry.mLoadShadersFromMemory) {
+			std::error_code ec;
+			if (!std::filesystem::exists(entry.mVertexShader, ec) || !std::filesystem::exists(entry.mFragmentShader, ec)) {
+				continue; // The shader files have been removed since recording
+			}
+		}
+		auto [vertexSource, fragmentSource] = loadGraphicsPipelineShaderSources(config, entry.mLoadShadersFromMemory);
+		if (hashString(vertexSource.mCode) != entry.mVertexShaderContentHash || hashString(fragmentSource.mCode) != entry.mFragmentShaderContentHash) {
+			++numChanged; // Prewarm it anyway, with the current shaders, since these are going to be requested
+		}
+		const auto configKey = computeGraphicsPipelineConfigKey(config, vertexSource, fragmentSource);
+		if (mPipelinesByConfigKey.end() != mPipelinesByConfigKey.find(configKey) || mPrewarmedPipelines.end() != mPrewarmedPipelines.find(configKey)) {
+			continue;
+		}
+		mPrewarmedPipelines.emplace(configKey, createGraphicsPipelineFromSourcesOnWorkerThreads(config, std::move(vertexSource), std::move(fragmentSource)));
+		++numPrewarmed;
+	}
+	VKL_LOG("Prewarming " << numPrewarmed << " graphics pipelines from pipeline manifest[" << manifest_path << "] on the worker threads"
+		<< (numChanged > 0 ? " (" + std::to_string(numChanged) + " of them with shaders which have changed since recording)." : "."));
+	return numPrewarmed;
 }
 
-VkPipeline createGraphicsPipelineInternal(const VklGraphicsPipelineConfig& config, bool loadShadersFromMemoryInstead)
+VkPipeline vklCreateGraphicsPipeline(const VklGraphicsPipelineConfig& config, bool loadShadersFromMemoryInstead)
 {
-    if (!loadShadersFromMemoryInstead && !vklFrameworkInitialized()) {
-        VKL_EXIT_WITH_ERROR("Framework not initialized. Ensure to invoke vklInitFramework beforehand!");
-    }
-    // Create the graphics pipeline, describe every state of it
-	// Get tuples of <vk::ShaderModule, vk::PipelineShaderStageCreateInfo>
-	auto vertTpl = loadShadersFromMemoryInstead
-		? loadShaderFromMemoryAndCreateShaderModuleAndStageInfo(config.vertexShaderPath, "vertex shader from memory", vk::ShaderStageFlagBits::eVertex)
-		: loadShaderFromFileAndCreateShaderModuleAndStageInfo(config.vertexShaderPath, vk::ShaderStageFlagBits::eVertex);
+	if (!vklFrameworkInitialized()) {
+		VKL_EXIT_WITH_ERROR("Framework not initialized. Ensure to invoke vklInitFramework beforehand!");
+	}
+	const auto t0 = std::chrono::steady_clock::now();
+
+	// Identical configs share one pipeline:
+	auto [vertexSource, fragmentSource] = loadGraphicsPipelineShaderSources(config, loadShadersFromMemoryInstead);
+	const auto configKey = computeGraphicsPipelineConfigKey(config, vertexSource, fragmentSource);
+	auto existing = mPipelinesByConfigKey.find(configKey);
+	if (mPipelinesByConfigKey.end() != existing) {
+		++std::get<uint32_t>(mPipelineReferences[existing->second]);
+		return existing->second;
+	}
 
-	if (!std::get<vk::ShaderModule>(vertTpl)) {
-		return VK_NULL_HANDLE;
+	std::vector<VklShaderFileDependency> shaderFiles;
+	VkPipeline graphicsPipeline = VK_NULL_HANDLE;
+	auto prewarmed = takePrewarmedPipeline(configKey);
+	if (prewarmed.mPipeline) {
+		shaderFiles = std::move(prewarmed.mShaderFiles);
+		graphicsPipeline = registerPipeline(std::move(prewarmed));
+	}
+	else {
+		graphicsPipeline = createGraphicsPipelineFromSources(config, std::move(vertexSource), std::move(fragmentSource), &shaderFiles);
+	}
+	if (!mFirstFramePresented) {
+		mStartupTimings.pipelinesMilliseconds += millisecondsSince(t0);
+	}
+	if (VK_NULL_HANDLE == graphicsPipeline) {
+        VKL_EXIT_WITH_ERROR("Failed to create graphics pipeline. Check console output if there were any problems with shader compilation!");
 	}
+	const auto graphicsPipelineHandle = allocatePipelineSlot(vk::PipelineBindPoint::eGraphics, graphicsPipeline, mPipelineLayouts.at(graphicsPipeline));
+	// Store for hot reloading, but only those handles, which the user requested explicitly (hence the split of createGraphicsPipelineInternal and vklCreateGraphicsPipeline):
+	findPipelineSlot(graphicsPipelineHandle)->mStaticViewportAndScissor = !config.dynamicViewportAndScissor;
+	mUserKnownPipelines[graphicsPipelineHandle] = std::make_tuple(config, 
+		std::string(nullptr != config.vertexShaderPath ? config.vertexShaderPath : ""), std::string(nullptr != config.fragmentShaderPath ? config.fragmentShaderPath : ""), 
+		loadShadersFromMemoryInstead, std::move(shaderFiles));
+	mShaderFileWatchesOutdated = true;
+	mPipelinesByConfigKey[configKey] = graphicsPipelineHandle;
+	mPipelineReferences[graphicsPipelineHandle] = std::make_tuple(configKey, 1u);
+	recordPipelineInManifest(config, loadShadersFromMemoryInstead);
+	scheduleLinkTimeOptimization(graphicsPipelineHandle);
+	return graphicsPipelineHandle;
+}
 
-	auto fragTpl = loadShadersFromMemoryInstead
-		? loadShaderFromMemoryAndCreateShaderModuleAndStageInfo(config.fragmentShaderPath, "fragment shader from memory", vk::ShaderStageFlagBits::eFragment)
-		: loadShaderFromFileAndCreateShaderModuleAndStageInfo(config.fragmentShaderPath, vk::ShaderStageFlagBits::eFragment);
+// Identifies a shader stage of a batch of pipelines, so that stages which are shared by multiple pipelines are compiled only once:
+std::string getShaderStageKey(const char* shaderPathOrCode, const uint32_t* spirv, size_t spirvSizeInBytes, const VklShaderCompileOptions& options, const vk::ShaderStageFlagBits shaderStage)
+{
+	std::string key = std::to_string(static_cast<uint32_t>(shaderStage)) + ':';
+	if (nullptr != spirv) {
+		return key + "spirv:" + std::to_string(reinterpret_cast<uintptr_t>(spirv)) + ':' + std::to_string(spirvSizeInBytes);
+	}
+	return key + std::to_string(hashShaderCompileOptions(options)) + ':' + (nullptr != shaderPathOrCode ? shaderPathOrCode : "");
+}
 
-	if (!std::get<vk::ShaderModule>(fragTpl)) {
-		mDevice.destroyShaderModule(std::get<vk::ShaderModule>(vertTpl));
-		return VK_NULL_HANDLE;
+std::vector<VkPipeline> vklCreateGraphicsPipelines(const std::vector<VklGraphicsPipelineConfig>& configs, bool loadShadersFromMemoryInstead)
+{
+	if (!vklFrameworkInitialized()) {
+		VKL_EXIT_WITH_ERROR("Framework not initialized. Ensure to invoke vklInitFramework beforehand!");
+	}
+	const auto t0 = std::chrono::steady_clock::now();
+
+	// Pipelines which have been prewarmed from a manifest are taken over, only the others are created below:
+	std::vector<VklPipelineObjects> prewarmed(configs.size());
+	if (!mPrewarmedPipelines.empty()) {
+		for (size_t i = 0; i < configs.size(); ++i) {
+			const auto& config = configs[i];
+			if (nullptr != config.vertexShaderSpirv || nullptr != config.fragmentShaderSpirv) {
+				continue; // => Never recorded in manifests
+			}
+			auto [vertexSource, fragmentSource] = loadGraphicsPipelineShaderSources(config, loadShadersFromMemoryInstead);
+			prewarmed[i] = takePrewarmedPipeline(computeGraphicsPipelineConfigKey(config, vertexSource, fragmentSource));
+		}
 	}
 
-	// Describe the shaders used:
-	std::array<vk::PipelineShaderStageCreateInfo, 2> shaderStages{ std::get<vk::PipelineShaderStageCreateInfo>(vertTpl), std::get<vk::PipelineShaderStageCreateInfo>(fragTpl) };
-	// Describe the vertex input, i.e. two vertex input attributes in our case:
+	// Compile every unique shader stage only once (unless it is in the shader module cache), all of them concurrently on the worker threads:
+	std::unordered_map<std::string, size_t> uniqueStageIndices;
+	std::vector<VklShaderModuleFuture> stageFutures;
+	std::vector<std::array<size_t, 2>> stageIndicesPerPipeline(configs.size());
+	const auto addStage = [&](const char* shaderPathOrCode, const uint32_t* spirv, size_t spirvSizeInBytes, const VklShaderCompileOptions& options, const vk::ShaderStageFlagBits shaderStage, const char* stageName) {
+		auto key = getShaderStageKey(shaderPathOrCode, spirv, spirvSizeInBytes, options, shaderStage);
+		auto it = uniqueStageIndices.find(key);
+		if (it != uniqueStageIndices.end()) {
+			return it->second;
+		}
+		stageFutures.push_back(nullptr != spirv
+			? getOrCreatePrecompiledShaderModule(spirv, spirvSizeInBytes, shaderStage)
+			: getOrCompileShaderModule(loadShaderSource(shaderPathOrCode, loadShadersFromMemoryInstead, stageName), options, shaderStage, /* on worker thread: */ true));
+		uniqueStageIndices.emplace(std::move(key), stageFutures.size() - 1);
+		return stageFutures.size() - 1;
+	};
+	for (size_t i = 0; i < configs.size(); ++i) {
+		if (prewarmed[i].mPipeline) {
+			continue;
+		}
+		const auto& config = configs[i];
+		stageIndicesPerPipeline[i][0] = addStage(config.vertexShaderPath,   config.vertexShaderSpirv,   config.vertexShaderSpirvSizeInBytes,   config.shaderCompileOptions, vk::ShaderStageFlagBits::eVertex,   "vertex");
+		stageIndicesPerPipeline[i][1] = addStage(config.fragmentShaderPath, config.fragmentShaderSpirv, config.fragmentShaderSpirvSizeInBytes, config.shaderCompileOptions, vk::ShaderStageFlagBits::eFragment, "fragment");
+	}
 
-	std::vector<vk::VertexInputBindingDescription> inputBufferBindings(std::begin(config.vertexInputBuffers), std::end(config.vertexInputBuffers));
-	std::vector<vk::VertexInputAttributeDescription> inputAttributeDescriptions(std::begin(config.inputAttributeDescriptions), std::end(config.inputAttributeDescriptions));
+	// There is one shader module per unique stage:
+	std::vector<std::shared_ptr<VklCachedShaderModule>> stages;
+	bool compilationFailed = false;
+	for (auto& stageFuture : stageFutures) {
+		stages.push_back(stageFuture.get());
+		compilationFailed = compilationFailed || !stages.back()->mModule;
+	}
+	if (compilationFailed) {
+		VKL_EXIT_WITH_ERROR("Failed to create graphics pipelines. Check console output if there were any problems with shader compilation!");
+	}
 
-	auto vertexInputState = vk::PipelineVertexInputStateCreateInfo{}
-		.setVertexBindingDescriptionCount(static_cast<uint32_t>(inputBufferBindings.size())).setPVertexBindingDescriptions(inputBufferBindings.data())
-		.setVertexAttributeDescriptionCount(static_cast<uint32_t>(inputAttributeDescriptions.size())).setPVertexAttributeDescriptions(inputAttributeDescriptions.data());
-	// Describe the topology of the vertices
-	auto inputAssemblyState = vk::PipelineInputAssemblyStateCreateInfo{}.setTopology(vk::PrimitiveTopology::eTriangleList);
-	// Describe viewport and scissors state
-	auto viewport = vk::Viewport{}
-		.setX(0.0f).setY(0.0f)
-		.setWidth(static_cast<float>(mSwapchainConfig.imageExtent.width)).setHeight(static_cast<float>(mSwapchainConfig.imageExtent.height))
-		.setMinDepth(0.0f).setMaxDepth(1.0f);
-	auto scissors = vk::Rect2D{}.setOffset({ 0, 0 }).setExtent(mSwapchainConfig.imageExtent);
-	auto viewportState = vk::PipelineViewportStateCreateInfo{}
-		.setViewportCount(1u).setPViewports(&viewport)
-		.setScissorCount(1u).setPScissors(&scissors);
-	// Describe the rasterizer state
-	auto rasterizerState = vk::PipelineRasterizationStateCreateInfo{}
-		.setPolygonMode(static_cast<vk::PolygonMode>(config.polygonDrawMode))
-		.setLineWidth(1.0f) // reasons...
-		.setCullMode(static_cast<vk::CullModeFlags>(config.triangleCullingMode))
-		.setFrontFace(vk::FrontFace::eCounterClockwise);
-	// Describe multisampling state
-	auto multisampleState = vk::PipelineMultisampleStateCreateInfo{}.setRasterizationSamples(vk::SampleCountFlagBits::e1);
-	// Configure depth/stencil state
-	auto depthStencilState = vk::PipelineDepthStencilStateCreateInfo{}
-		.setDepthTestEnable( mHasDepthAttachments ? VK_TRUE : VK_FALSE)
-		.setDepthWriteEnable(mHasDepthAttachments ? VK_TRUE : VK_FALSE)
-		.setDepthCompareOp(vk::CompareOp::eLess);
-	// Configure blending and which color channels are written
-	auto colorBlendAttachmentState = vk::PipelineColorBlendAttachmentState{}
-		.setBlendEnable(VK_FALSE)
-		.setColorWriteMask(vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG | vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA); // write all color components
+	// Describe all pipelines, and create them with one call, which allows the driver to create them in parallel:
+	std::vector<VklGraphicsPipelineDescription> descriptions(configs.size());
+	std::vector<vk::GraphicsPipelineCreateInfo> pipelineCreateInfos;
+	std::vector<size_t> createInfoIndices(configs.size());
+	pipelineCreateInfos.reserve(configs.size());
+	for (size_t i = 0; i < configs.size(); ++i) {
+		if (prewarmed[i].mPipeline) {
+			continue;
+		}
+		describeGraphicsPipeline(descriptions[i], configs[i],
+			getShaderStageCreateInfo(*stages[stageIndicesPerPipeline[i][0]]),
+			getShaderStageCreateInfo(*stages[stageIndicesPerPipeline[i][1]]));
+		createInfoIndices[i] = pipelineCreateInfos.size();
+		pipelineCreateInfos.push_back(descriptions[i].mCreateInfo);
+	}
+	std::vector<vk::Pipeline> graphicsPipelines;
+	if (!pipelineCreateInfos.empty()) {
+		graphicsPipelines = createGraphicsPipelinesFromModulesOrIdentifiers(pipelineCreateInfos);
+	}
 
-	if (config.enableAlphaBlending) {
-		colorBlendAttachmentState
-			.setBlendEnable(VK_TRUE)
-			.setSrcColorBlendFactor(vk::BlendFactor::eSrcAlpha)
-			.setDstColorBlendFactor(vk::BlendFactor::eOneMinusSrcAlpha)
-			.setColorBlendOp(vk::BlendOp::eAdd)
-			.setSrcAlphaBlendFactor(vk::BlendFactor::eSrcAlpha)
-			.setDstAlphaBlendFactor(vk::BlendFactor::eOneMinusSrcAlpha)
-			.setAlphaBlendOp(vk::BlendOp::eAdd);
+	std::vector<VkPipeline> graphicsPipelineHandles;
+	graphicsPipelineHandles.reserve(configs.size());
+	for (size_t i = 0; i < configs.size(); ++i) {
+		const auto& config = configs[i];
+		VkPipeline graphicsPipelineHandle;
+		std::vector<VklShaderFileDependency> shaderFiles;
+		if (prewarmed[i].mPipeline) {
+			shaderFiles = std::move(prewarmed[i].mShaderFiles);
+			const auto graphicsPipeline = registerPipeline(std::move(prewarmed[i]));
+			graphicsPipelineHandle = allocatePipelineSlot(vk::PipelineBindPoint::eGraphics, graphicsPipeline, mPipelineLayouts.at(graphicsPipeline));
+			scheduleLinkTimeOptimization(graphicsPipelineHandle);
+		}
+		else {
+			auto objects = getGraphicsPipelineObjects(descriptions[i], graphicsPipelines[createInfoIndices[i]]);
+			objects.mSpirvHash = hashPipelineSpirv(*stages[stageIndicesPerPipeline[i][0]], *stages[stageIndicesPerPipeline[i][1]]);
+			auto layouts = objects.mLayouts;
+			graphicsPipelineHandle = allocatePipelineSlot(vk::PipelineBindPoint::eGraphics, registerPipeline(std::move(objects)), std::move(layouts));
+			shaderFiles = stages[stageIndicesPerPipeline[i][0]]->mShader.mFiles;
+			appendShaderFiles(shaderFiles, stages[stageIndicesPerPipeline[i][1]]->mShader.mFiles);
+		}
+		// Store for hot reloading, just like vklCreateGraphicsPipeline does:
+		findPipelineSlot(graphicsPipelineHandle)->mStaticViewportAndScissor = !config.dynamicViewportAndScissor;
+		mUserKnownPipelines[graphicsPipelineHandle] = std::make_tuple(config,
+			std::string(nullptr != config.vertexShaderPath ? config.vertexShaderPath : ""), std::string(nullptr != config.fragmentShaderPath ? config.fragmentShaderPath : ""),
+			loadShadersFromMemoryInstead, std::move(shaderFiles));
+		mShaderFileWatchesOutdated = true;
+		recordPipelineInManifest(config, loadShadersFromMemoryInstead);
+		graphicsPipelineHandles.push_back(graphicsPipelineHandle);
 	}
 
-	auto colorBlendState = vk::PipelineColorBlendStateCreateInfo{}.setAttachmentCount(1u).setPAttachments(&colorBlendAttachmentState);
-	
-	// But again: not so fast! We have to define the LAYOUT of our descriptors first
-	std::vector<vk::DescriptorSetLayoutBinding> layoutBindings(std::begin(config.descriptorLayout), std::end(config.descriptorLayout));
-	auto descriptorSetLayout = mDevice.createDescriptorSetLayoutUnique(
-		vk::DescriptorSetLayoutCreateInfo{}
-			.setBindingCount(static_cast<uint32_t>(layoutBindings.size()))
-			.setPBindings(layoutBindings.data())
-		, nullptr, mDispatchLoader
-	);
+	if (!mFirstFramePresented) {
+		mStartupTimings.pipelinesMilliseconds += millisecondsSince(t0);
+	}
+	return graphicsPipelineHandles;
+}
 
-	// Continue with configuring our graphics pipeline:
-	// Create a PIPELINE LAYOUT which describes all RESOURCES that are passed in to our pipeline (Resource Descriptors that we have created above)
-	auto pipelineLayout = mDevice.createPipelineLayoutUnique(
-		vk::PipelineLayoutCreateInfo{} // A pipeline's layout describes all resources used by a pipeline or in shaders.
-			.setSetLayoutCount(1u)
-			.setPSetLayouts(&descriptorSetLayout.get()) // We don't need the actual descriptors when defining the PIPELINE. The LAYOUT is sufficient at this point.
-		, nullptr, mDispatchLoader
-	);
+VkPipeline vklCreateGraphicsPipelineAsync(const VklGraphicsPipelineConfig& config, VkPipeline fallbackPipeline, bool loadShadersFromMemoryInstead)
+{
+	if (!vklFrameworkInitialized()) {
+		VKL_EXIT_WITH_ERROR("Framework not initialized. Ensure to invoke vklInitFramework beforehand!");
+	}
 
-	// Put everything together:
-	auto pipelineCreateInfo = vk::GraphicsPipelineCreateInfo{}
-		.setStageCount(static_cast<uint32_t>(shaderStages.size())).setPStages(shaderStages.data())
-		.setPVertexInputState(&vertexInputState)
-		.setPInputAssemblyState(&inputAssemblyState)
-		.setPViewportState(&viewportState)
-		.setPRasterizationState(&rasterizerState)
-		.setPMultisampleState(&multisampleState)
-		.setPDepthStencilState(&depthStencilState)
-		.setPColorBlendState(&colorBlendState)
-		.setLayout(pipelineLayout.get())
-		.setRenderPass(mRenderpass.get()).setSubpass(0u); // <--- Which subpass of the given renderpass we are going to use this graphics pipeline for
-	// FINALLY:
-	auto graphicsPipeline = mDevice.createGraphicsPipeline(nullptr, pipelineCreateInfo).value;
-	
-	// Don't need the modules anymore:
-	mDevice.destroyShaderModule(std::get<vk::ShaderModule>(fragTpl));
-	mDevice.destroyShaderModule(std::get<vk::ShaderModule>(vertTpl));
+	// The layouts are available right away (for vklGetLayoutForPipeline and vklBindDescriptorSetToPipeline),
+	// and they are the same interned layouts which the actual pipeline will be created with:
+	const auto pipelineHandle = allocatePipelineSlot(vk::PipelineBindPoint::eGraphics, VK_NULL_HANDLE, getOrCreatePipelineLayouts(config), fallbackPipeline);
+	// A pipeline which is being prewarmed from a manifest is taken over (without waiting for it), otherwise it is created from scratch:
+	std::future<VklPipelineObjects> creation;
+	if (!mPrewarmedPipelines.empty() && nullptr == config.vertexShaderSpirv && nullptr == config.fragmentShaderSpirv) {
+		auto [vertexSource, fragmentSource] = loadGraphicsPipelineShaderSources(config, loadShadersFromMemoryInstead);
+		auto prewarmed = mPrewarmedPipelines.find(computeGraphicsPipelineConfigKey(config, vertexSource, fragmentSource));
+		if (mPrewarmedPipelines.end() != prewarmed) {
+			creation = std::move(prewarmed->second);
+			mPrewarmedPipelines.erase(prewarmed);
+		}
+	}
+	if (!creation.valid()) {
+		creation = createGraphicsPipelineOnWorkerThreads(config, config.vertexShaderPath, config.fragmentShaderPath, loadShadersFromMemoryInstead);
+	}
+	mPendingPipelineCreations[pipelineHandle] = std::move(creation);
+	// Store for hot reloading, the shader files are added once the pipeline is ready:
+	findPipelineSlot(pipelineHandle)->mStaticViewportAndScissor = !config.dynamicViewportAndScissor;
+	mUserKnownPipelines[pipelineHandle] = std::make_tuple(config,
+		std::string(nullptr != config.vertexShaderPath ? config.vertexShaderPath : ""), std::string(nullptr != config.fragmentShaderPath ? config.fragmentShaderPath : ""),
+		loadShadersFromMemoryInstead, std::vector<VklShaderFileDependency>{});
+	mShaderFileWatchesOutdated = true;
+	recordPipelineInManifest(config, loadShadersFromMemoryInstead);
+	return pipelineHandle;
+}
 
-	auto graphicsPipelineHandle = static_cast<VkPipeline>(graphicsPipeline);
+VkPipeline vklCreateComputePipeline(const VklComputePipelineConfig& config, bool loadShaderFromMemoryInstead)
+{
+	if (!vklFrameworkInitialized()) {
+		VKL_EXIT_WITH_ERROR("Framework not initialized. Ensure to invoke vklInitFramework beforehand!");
+	}
 
-	mPipelineLayouts[graphicsPipelineHandle] = std::forward_as_tuple(std::move(descriptorSetLayout), std::move(pipelineLayout));
-	return graphicsPipelineHandle;
+	auto computeModule = getComputeShaderModule(config, config.computeShaderPath, loadShaderFromMemoryInstead, /* on worker thread: */ false);
+	const auto& compute = *computeModule.get();
+	if (!compute.mModule) {
+		VKL_EXIT_WITH_ERROR("Failed to create compute pipeline. Check console output if there were any problems with shader compilation!");
+	}
+	auto objects = buildComputePipelineFromShaderModule(config, compute);
+	auto layouts = objects.mLayouts;
+	const auto pipelineHandle = allocatePipelineSlot(vk::PipelineBindPoint::eCompute, registerPipeline(std::move(objects)), std::move(layouts));
+	// Store for hot reloading:
+	mUserKnownComputePipelines[pipelineHandle] = std::make_tuple(config,
+		std::string(nullptr != config.computeShaderPath ? config.computeShaderPath : ""), loadShaderFromMemoryInstead, compute.mShader.mFiles);
+	mShaderFileWatchesOutdated = true;
+	return pipelineHandle;
 }
 
-VkPipeline vklCreateGraphicsPipeline(const VklGraphicsPipelineConfig& config, bool loadShadersFromMemoryInstead)
+void vklDestroyComputePipeline(VkPipeline pipeline)
 {
-	auto graphicsPipelineHandle = createGraphicsPipelineInternal(config, loadShadersFromMemoryInstead);
-	if (VK_NULL_HANDLE == graphicsPipelineHandle) {
-        VKL_EXIT_WITH_ERROR("Failed to create graphics pipeline. Check console output if there were any problems with shader compilation!");
+	if (!vklFrameworkInitialized()) {
+		VKL_EXIT_WITH_ERROR("Framework not initialized. Ensure to not invoke vklDestroyFramework beforehand!");
 	}
-	// Store for hot reloading, but only those handles, which the user requested explicitly (hence the split of createGraphicsPipelineInternal and vklCreateGraphicsPipeline):
-	mUserKnownPipelines[graphicsPipelineHandle] = std::make_tuple(config, std::string(config.vertexShaderPath), std::string(config.fragmentShaderPath), loadShadersFromMemoryInstead);
-	return graphicsPipelineHandle;
+	auto* slot = findPipelineSlot(pipeline);
+	if (nullptr == slot || vk::PipelineBindPoint::eCompute != slot->mBindPoint) {
+		VKL_EXIT_WITH_ERROR("Couldn't find the VkPipeline passed to vklDestroyComputePipeline. Is it a valid handle, which has been created with vklCreateComputePipeline(...) and has not been destroyed yet?");
+	}
+	// Previous versions of the pipeline are still in the graveyard, and destroyed from there:
+	destroyPipelineInternal(slot->mPipeline);
+	freePipelineSlot(*slot);
+	mUserKnownComputePipelines.erase(pipeline);
+	mShaderFileWatchesOutdated = true;
 }
 
-VkPipeline getGraphicsPipelineOrItsSurrogate(VkPipeline originalPipelineHandle)
+void vklEnableGraphicsPipelineLibrary(bool enable)
 {
-	auto it = mPipelineSurrogates.find(originalPipelineHandle);
-	if (it != mPipelineSurrogates.end()) {
-		return it->second; // using the surrogate/updated pipeline
+	if (vklFrameworkInitialized()) {
+		VKL_EXIT_WITH_ERROR("vklEnableGraphicsPipelineLibrary must be invoked before vklInitFramework.");
 	}
-	return originalPipelineHandle;
+	mGraphicsPipelineLibraryRequested = enable;
 }
 
-void destroyGraphicsPipelineInternal(VkPipeline pipeline)
+bool vklIsGraphicsPipelineLibraryInUse()
 {
-	mDevice.destroy(vk::Pipeline{ pipeline });
+	return mGraphicsPipelineLibraryInUse;
+}
 
-	// Also remove it from the graveyard:
-	mPipelineGraveyard.erase(std::remove_if(
-			mPipelineGraveyard.begin(),
-			mPipelineGraveyard.end(),
-			[pipeline](const std::tuple<int64_t, VkPipeline>& element) { 
-				return std::get<1>(element) == pipeline; 
-			}
-		), mPipelineGraveyard.end());
-	// ...and as a surrogate (i.e., "pointed to"):
-	for(auto it = mPipelineSurrogates.begin(); it != mPipelineSurrogates.end();) {
-		if (it->second == pipeline) {
-			it = mPipelineSurrogates.erase(it);
-		}
-		else {
-			++it;
-		}
+bool vklIsPipelineReady(VkPipeline pipeline)
+{
+	return VK_NULL_HANDLE != resolvePipelineHandle(pipeline);
+}
+
+// Destroys an actual pipeline (i.e., not a slot handle). It must neither be the current pipeline of a slot, nor be in the graveyard anymore.
+void destroyPipelineInternal(VkPipeline pipeline)
+{
+	mDevice.destroy(vk::Pipeline{ pipeline });
+	mPipelineSpirvHashes.erase(pipeline);
+	// Release its layouts, which are destroyed when no other pipeline uses them anymore:
+	mPipelineLayouts.erase(pipeline);
+	// ...and the libraries it has been linked from, which are destroyed when no other pipeline has been linked from them:
+	{
+		std::lock_guard<std::mutex> lock(mPipelineLibrariesMutex);
+		mFastLinkedPipelines.erase(pipeline);
+		mOptimizedPipelineLibraries.erase(pipeline);
 	}
 	// but NOT from known pipelines!
 }
@@ -720,92 +3243,406 @@ void vklDestroyGraphicsPipeline(VkPipeline pipeline)
 		VKL_EXIT_WITH_ERROR("Framework not initialized. Ensure to not invoke vklDestroyFramework beforehand!");
 	}
 
-	// Destroy the latest surrogate:
-	destroyGraphicsPipelineInternal(getGraphicsPipelineOrItsSurrogate(pipeline));
+	// Shared pipelines are only destroyed when their last reference is released:
+	auto references = mPipelineReferences.find(pipeline);
+	if (mPipelineReferences.end() != references) {
+		if (--std::get<uint32_t>(references->second) > 0) {
+			return;
+		}
+		mPipelinesByConfigKey.erase(std::get<uint64_t>(references->second));
+		mPipelineReferences.erase(references);
+	}
+
+	auto* slot = findPipelineSlot(pipeline);
+	if (nullptr == slot || vk::PipelineBindPoint::eGraphics != slot->mBindPoint) {
+		VKL_EXIT_WITH_ERROR("Couldn't find the VkPipeline passed to vklDestroyGraphicsPipeline. Is it a valid handle, which has been created with vklCreateGraphicsPipeline(...) and has not been destroyed yet?");
+	}
+
+	auto pendingCreation = mPendingPipelineCreations.find(pipeline);
+	if (mPendingPipelineCreations.end() != pendingCreation) {
+		// There is no pipeline yet, it will be destroyed once it has been created:
+		if (pendingCreation->second.valid()) {
+			mAbandonedPipelineCreations.push_back(std::move(pendingCreation->second));
+		}
+		mPendingPipelineCreations.erase(pendingCreation);
+	}
+	else {
+		// Destroy the latest version of the pipeline. Previous versions are still in the graveyard, and destroyed from there:
+		destroyPipelineInternal(slot->mPipeline);
+	}
+	// Stale copies of the handle do not resolve to anything anymore:
+	freePipelineSlot(*slot);
 
-	// Remove the ORIGINAL pipeline handle from known pipelines:
+	// Remove the handle from known pipelines:
 	auto it = mUserKnownPipelines.find(pipeline);
 	if (it != mUserKnownPipelines.end()) {
 		mUserKnownPipelines.erase(it);
+		mShaderFileWatchesOutdated = true;
+	}
+}
+
+// The memory properties of the physical device, queried once in vklInitFramework, and the memory types which
+// have been selected for combinations of <memoryTypeBits, required flags, preferred flags> so far:
+vk::PhysicalDeviceMemoryProperties mMemoryProperties;
+std::unordered_map<uint64_t, uint32_t> mMemoryTypeLookup;
+
+// Returns the index of the best memory type among the allowed memory_type_bits which has all required flags, or -1 if there is none.
+// Types with more of the preferred flags win. Among those, types with fewer flags which have been neither required nor
+// preferred win (so that, e.g., the small host-visible part of device-local memory is left for those asking for it),
+// and the type with the largest heap wins ties.
+int findMemoryTypeIndex(uint32_t memory_type_bits, vk::MemoryPropertyFlags required_flags, vk::MemoryPropertyFlags preferred_flags)
+{
+	const uint64_t key = (static_cast<uint64_t>(memory_type_bits) << 32)
+		| (static_cast<uint64_t>(static_cast<VkMemoryPropertyFlags>(required_flags) & 0xFFFFu) << 16)
+		| (static_cast<uint64_t>(static_cast<VkMemoryPropertyFlags>(preferred_flags) & 0xFFFFu));
+	auto search = mMemoryTypeLookup.find(key);
+	if (mMemoryTypeLookup.end() != search) {
+		return static_cast<int>(search->second);
 	}
-	// ...and potentially also from surrogate list (if it is the "points from" entry):
-	for(auto it = mPipelineSurrogates.begin(); it != mPipelineSurrogates.end();) {
-		if (it->first == pipeline) {
-			it = mPipelineSurrogates.erase(it);
+
+	auto countFlags = [](vk::MemoryPropertyFlags flags) {
+		int count = 0;
+		for (auto bits = static_cast<VkMemoryPropertyFlags>(flags); 0 != bits; bits &= bits - 1) {
+			++count;
 		}
-		else {
-			++it;
+		return count;
+	};
+
+	int selectedMemIndex = -1;
+	std::tuple<int, int, vk::DeviceSize> selectedScore;
+	for (uint32_t i = 0; i < mMemoryProperties.memoryTypeCount; ++i) {
+		const auto propertyFlags = mMemoryProperties.memoryTypes[i].propertyFlags;
+		if (0 == (memory_type_bits & (1u << i)) || (propertyFlags & required_flags) != required_flags) {
+			continue;
+		}
+		const auto score = std::make_tuple(
+			countFlags(propertyFlags & preferred_flags),
+			-countFlags(propertyFlags & ~(required_flags | preferred_flags)),
+			mMemoryProperties.memoryHeaps[mMemoryProperties.memoryTypes[i].heapIndex].size);
+		if (-1 == selectedMemIndex || score > selectedScore) {
+			selectedMemIndex = static_cast<int>(i);
+			selectedScore = score;
 		}
 	}
+
+	if (-1 != selectedMemIndex) {
+		mMemoryTypeLookup[key] = static_cast<uint32_t>(selectedMemIndex);
+	}
+	return selectedMemIndex;
 }
 
 vk::MemoryAllocateInfo vklCreateMemoryAllocateInfo(vk::DeviceSize bufferSize, vk::MemoryRequirements memoryRequirements, vk::MemoryPropertyFlags memoryPropertyFlags) {
-	auto memoryAllocInfo = vk::MemoryAllocateInfo{}
+	const int selectedMemIndex = findMemoryTypeIndex(memoryRequirements.memoryTypeBits, memoryPropertyFlags, vk::MemoryPropertyFlags{});
+	if (-1 == selectedMemIndex) {
+		VKL_EXIT_WITH_ERROR(std::string("ERROR: Couldn't find suitable memory of size[") + std::to_string(bufferSize) + "] and requirements[" + std::to_string(memoryRequirements.alignment) + ", " + std::to_string(memoryRequirements.memoryTypeBits) + ", " + std::to_string(memoryRequirements.size) + "]");
+	}
+
+	// all good, we found a suitable memory index:
+	return vk::MemoryAllocateInfo{}
 		.setAllocationSize(std::max(bufferSize, memoryRequirements.size))
-		.setMemoryTypeIndex([&]() {
-			// Get memory types supported by the physical device:
-			auto memoryProperties = mPhysicalDevice.getMemoryProperties();
-
-			// In search for a suitable memory type INDEX:
-			int selectedMemIndex = -1;
-			vk::DeviceSize selectedHeapSize = 0;
-			for (int i = 0; i < static_cast<int>(memoryProperties.memoryTypeCount); ++i) {
-
-				// Is this kind of memory suitable for our buffer?
-				const auto bitmask = memoryRequirements.memoryTypeBits;
-				const auto bit = 1 << i;
-				if (0 == (bitmask & bit)) {
-					continue; // => nope
-				}
+		.setMemoryTypeIndex(static_cast<uint32_t>(selectedMemIndex));
+}
+
+VkMemoryAllocateInfo vklCreateMemoryAllocateInfo(VkDeviceSize bufferSize, VkMemoryRequirements memoryRequirements, VkMemoryPropertyFlags memoryPropertyFlags) {
+  return static_cast<VkMemoryAllocateInfo>(vklCreateMemoryAllocateInfo(static_cast<vk::DeviceSize>(bufferSize), static_cast<vk::MemoryRequirements>(memoryRequirements), static_cast<vk::MemoryPropertyFlags>(memoryPropertyFlags)));
+}
+
+VkDeviceMemory vklAllocateMemoryForGivenRequirements(VkDeviceSize bufferSize, VkMemoryRequirements memoryRequirements, VkMemoryPropertyFlags memoryPropertyFlags)
+{
+    const auto memoryAllocInfo = vklCreateMemoryAllocateInfo(bufferSize, memoryRequirements, memoryPropertyFlags);
+
+	// Allocate:
+	VkDeviceMemory memory;
+    VkResult returnCode = vkAllocateMemory(static_cast<VkDevice>(mDevice), &memoryAllocInfo, NULL, &memory);
+	if (returnCode == VK_SUCCESS) {
+		return memory;
+	}
+	else {
+    	VKL_EXIT_WITH_ERROR(std::string("Error allocating memory of size [") + std::to_string(bufferSize) + "] and requirements[" + std::to_string(memoryRequirements.alignment) + ", " + std::to_string(memoryRequirements.memoryTypeBits) + ", " + std::to_string(memoryRequirements.size) + "]\n    Error Code: " + to_string(returnCode));
+	}
+}
+
+vk::UniqueDeviceMemory vklAllocateMemoryForGivenRequirements(vk::DeviceSize bufferSize, vk::MemoryRequirements memoryRequirements, vk::MemoryPropertyFlags memoryPropertyFlags) {
+  const auto memoryAllocInfo = vklCreateMemoryAllocateInfo(bufferSize, memoryRequirements, memoryPropertyFlags);
+  auto allocatedMemory = mDevice.allocateMemoryUnique(memoryAllocInfo, nullptr, mDispatchLoader);
+  return allocatedMemory;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Built-in memory allocator. Without VMA, buffers and images are sub-allocated from large blocks of device memory, so that creating many small
+// resources neither costs one vkAllocateMemory call each, nor runs into maxMemoryAllocationCount.
+
+VklMemoryAllocatorConfig mMemoryAllocatorConfig = {};
+VklMemoryAllocatorStatistics mMemoryAllocatorStatistics = {};
+
+struct VklMemoryBlock {
+	vk::DeviceMemory mMemory;
+	vk::DeviceSize mSize = 0;
+	uint8_t* mMappedData = nullptr; // Persistently mapped, if the block's memory type is host-visible
+	uint32_t mPoolKey = 0;          // Key of the block's list in mMemoryBlocks
+	bool mLinear = false;           // Allocated from like a stack, see VklMemoryAllocatorConfig::linear
+
+	// Free ranges of a non-linear block, both by offset (for coalescing neighbors) and by size (for best-fit searches):
+	std::map<vk::DeviceSize, vk::DeviceSize> mFreeRangesByOffset;
+	std::multimap<vk::DeviceSize, vk::DeviceSize> mFreeRangesBySize;
+
+	// Allocation head of a linear block, which is rewound once all of the block's allocations have been freed:
+	vk::DeviceSize mLinearOffset = 0;
+
+	uint32_t mAllocationCount = 0;
+	vk::DeviceSize mUsedBytes = 0;
+};
+
+// The blocks of every memory type. Buffers and optimal-tiling images never share a block, which is why the
+// bufferImageGranularity never has to be taken into account between neighboring allocations of the same block:
+std::unordered_map<uint32_t, std::vector<std::unique_ptr<VklMemoryBlock>>> mMemoryBlocks;
+
+uint32_t memoryPoolKey(uint32_t memoryTypeIndex, bool optimalImage)
+{
+	return memoryTypeIndex * 2u + (optimalImage ? 1u : 0u);
+}
+
+vk::DeviceSize alignMemoryOffset(vk::DeviceSize offset, vk::DeviceSize alignment)
+{
+	return 0 == alignment ? offset : (offset + alignment - 1) / alignment * alignment;
+}
+
+void addFreeMemoryRange(VklMemoryBlock& block, vk::DeviceSize offset, vk::DeviceSize size)
+{
+	block.mFreeRangesByOffset[offset] = size;
+	block.mFreeRangesBySize.emplace(size, offset);
+}
+
+void removeFreeMemoryRange(VklMemoryBlock& block, vk::DeviceSize offset, vk::DeviceSize size)
+{
+	block.mFreeRangesByOffset.erase(offset);
+	auto range = block.mFreeRangesBySize.equal_range(size);
+	for (auto it = range.first; it != range.second; ++it) {
+		if (it->second == offset) {
+			block.mFreeRangesBySize.erase(it);
+			return;
+		}
+	}
+}
+
+// Tries to reserve size bytes at the given alignment within the given block, and returns whether that worked:
+bool allocateFromMemoryBlock(VklMemoryBlock& block, vk::DeviceSize size, vk::DeviceSize alignment, vk::DeviceSize& out_offset)
+{
+	if (block.mLinear) {
+		const auto offset = alignMemoryOffset(block.mLinearOffset, alignment);
+		if (offset + size > block.mSize) {
+			return false;
+		}
+		block.mLinearOffset = offset + size;
+		out_offset = offset;
+		return true;
+	}
+
+	// Best fit: Take the smallest free range which can hold the allocation after its start has been aligned:
+	for (auto it = block.mFreeRangesBySize.lower_bound(size); it != block.mFreeRangesBySize.end(); ++it) {
+		const auto rangeOffset = it->second;
+		const auto rangeSize = it->first;
+		const auto offset = alignMemoryOffset(rangeOffset, alignment);
+		if (offset + size > rangeOffset + rangeSize) {
+			continue;
+		}
+
+		removeFreeMemoryRange(block, rangeOffset, rangeSize);
+		// Return the padding in front of the allocation and the rest behind it to the free list:
+		if (offset > rangeOffset) {
+			addFreeMemoryRange(block, rangeOffset, offset - rangeOffset);
+		}
+		if (rangeOffset + rangeSize > offset + size) {
+			addFreeMemoryRange(block, offset + size, rangeOffset + rangeSize - offset - size);
+		}
+		out_offset = offset;
+		return true;
+	}
+	return false;
+}
+
+void freeFromMemoryBlock(VklMemoryBlock& block, vk::DeviceSize offset, vk::DeviceSize size)
+{
+	if (block.mLinear) {
+		if (0 == block.mAllocationCount) {
+			block.mLinearOffset = 0;
+		}
+		return;
+	}
+
+	// Coalesce with the free ranges right behind and right in front of the freed range:
+	auto next = block.mFreeRangesByOffset.lower_bound(offset);
+	if (block.mFreeRangesByOffset.end() != next && next->first == offset + size) {
+		const auto nextSize = next->second;
+		removeFreeMemoryRange(block, offset + size, nextSize);
+		size += nextSize;
+	}
+	next = block.mFreeRangesByOffset.lower_bound(offset);
+	if (block.mFreeRangesByOffset.begin() != next) {
+		auto prev = std::prev(next);
+		if (prev->first + prev->second == offset) {
+			const auto prevOffset = prev->first;
+			const auto prevSize = prev->second;
+			removeFreeMemoryRange(block, prevOffset, prevSize);
+			offset = prevOffset;
+			size += prevSize;
+		}
+	}
+	addFreeMemoryRange(block, offset, size);
+}
+
+// Allocates memory for a buffer (optimal_image == false) or an optimal-tiling image (optimal_image == true) from a memory type which has all
+// required_flags, and as many of the preferred_flags as possible (see findMemoryTypeIndex).
+// Host-visible memory is mapped persistently, i.e., the returned allocation's mMappedData can be written to until it is freed.
+VklMemoryAllocation allocateResourceMemory(const vk::MemoryRequirements& memory_requirements, vk::MemoryPropertyFlags required_flags, vk::MemoryPropertyFlags preferred_flags, bool optimal_image)
+{
+	const int selectedMemIndex = findMemoryTypeIndex(memory_requirements.memoryTypeBits, required_flags, preferred_flags);
+	if (-1 == selectedMemIndex) {
+		VKL_EXIT_WITH_ERROR(std::string("ERROR: Couldn't find suitable memory of size[") + std::to_string(memory_requirements.size) + "] and requirements[" + std::to_string(memory_requirements.alignment) + ", " + std::to_string(memory_requirements.memoryTypeBits) + ", " + std::to_string(memory_requirements.size) + "]");
+	}
+	const auto memoryTypeIndex = static_cast<uint32_t>(selectedMemIndex);
+	const bool hostVisible = static_cast<bool>(mMemoryProperties.memoryTypes[memoryTypeIndex].propertyFlags & vk::MemoryPropertyFlagBits::eHostVisible);
+	const auto size = memory_requirements.size;
+
+	VklMemoryAllocation allocation;
+	allocation.mSize = size;
+
+	// Resources which would fill a large part of a block get memory of their own:
+	if (!mMemoryAllocatorConfig.enabled || size > mMemoryAllocatorConfig.blockSizeInBytes / 2) {
+		allocation.mMemory = mDevice.allocateMemory(vk::MemoryAllocateInfo{ size, memoryTypeIndex });
+		if (hostVisible) {
+			allocation.mMappedData = static_cast<uint8_t*>(mDevice.mapMemory(allocation.mMemory, 0, VK_WHOLE_SIZE));
+		}
+		mMemoryAllocatorStatistics.dedicatedAllocationCount++;
+		mMemoryAllocatorStatistics.allocatedBytes += size;
+		mMemoryAllocatorStatistics.usedBytes += size;
+		return allocation;
+	}
+
+	const auto poolKey = memoryPoolKey(memoryTypeIndex, optimal_image);
+	auto& blocks = mMemoryBlocks[poolKey];
+	VklMemoryBlock* block = nullptr;
+	for (auto& candidate : blocks) {
+		if (candidate->mLinear == mMemoryAllocatorConfig.linear && allocateFromMemoryBlock(*candidate, size, memory_requirements.alignment, allocation.mOffset)) {
+			block = candidate.get();
+			break;
+		}
+	}
+
+	if (nullptr == block) {
+		auto newBlock = std::make_unique<VklMemoryBlock>();
+		newBlock->mSize = mMemoryAllocatorConfig.blockSizeInBytes;
+		newBlock->mMemory = mDevice.allocateMemory(vk::MemoryAllocateInfo{ newBlock->mSize, memoryTypeIndex });
+		if (hostVisible) {
+			newBlock->mMappedData = static_cast<uint8_t*>(mDevice.mapMemory(newBlock->mMemory, 0, VK_WHOLE_SIZE));
+		}
+		newBlock->mPoolKey = poolKey;
+		newBlock->mLinear = mMemoryAllocatorConfig.linear;
+		if (!newBlock->mLinear) {
+			addFreeMemoryRange(*newBlock, 0, newBlock->mSize);
+		}
+		allocateFromMemoryBlock(*newBlock, size, memory_requirements.alignment, allocation.mOffset);
+		mMemoryAllocatorStatistics.blockCount++;
+		mMemoryAllocatorStatistics.allocatedBytes += newBlock->mSize;
+		block = newBlock.get();
+		blocks.push_back(std::move(newBlock));
+	}
+
+	block->mAllocationCount++;
+	block->mUsedBytes += size;
+	mMemoryAllocatorStatistics.subAllocationCount++;
+	mMemoryAllocatorStatistics.usedBytes += size;
 
-				// Does this kind of memory support our usage requirements?
-				if ((memoryProperties.memoryTypes[i].propertyFlags & (memoryPropertyFlags)) != vk::MemoryPropertyFlags{}) {
-					// Would support => now select the one with the largest heap:
-					const auto heapSize = memoryProperties.memoryHeaps[memoryProperties.memoryTypes[i].heapIndex].size;
-					if (heapSize > selectedHeapSize) {
-						// We have a new king:
-						selectedMemIndex = i;
-						selectedHeapSize = heapSize;
-					}
-				}
-			}
+	allocation.mMemory = block->mMemory;
+	allocation.mMappedData = nullptr != block->mMappedData ? block->mMappedData + allocation.mOffset : nullptr;
+	allocation.mBlock = block;
+	return allocation;
+}
 
-			if (-1 == selectedMemIndex) {
-				VKL_EXIT_WITH_ERROR(std::string("ERROR: Couldn't find suitable memory of size[") + std::to_string(bufferSize) + "] and requirements[" + std::to_string(memoryRequirements.alignment) + ", " + std::to_string(memoryRequirements.memoryTypeBits) + ", " + std::to_string(memoryRequirements.size) + "]");
-			}
+void freeResourceMemory(const VklMemoryAllocation& allocation)
+{
+	mMemoryAllocatorStatistics.usedBytes -= allocation.mSize;
+	if (nullptr == allocation.mBlock) {
+		mDevice.freeMemory(allocation.mMemory);
+		mMemoryAllocatorStatistics.dedicatedAllocationCount--;
+		mMemoryAllocatorStatistics.allocatedBytes -= allocation.mSize;
+		return;
+	}
 
-			// all good, we found a suitable memory index:
-			return static_cast<uint32_t>(selectedMemIndex);
-		}());
-	return memoryAllocInfo;
+	auto& block = *allocation.mBlock;
+	block.mAllocationCount--;
+	block.mUsedBytes -= allocation.mSize;
+	freeFromMemoryBlock(block, allocation.mOffset, allocation.mSize);
+	mMemoryAllocatorStatistics.subAllocationCount--;
+
+	// Release empty blocks, but keep the last one of each memory type around for subsequent allocations:
+	auto& blocks = mMemoryBlocks[block.mPoolKey];
+	if (0 == block.mAllocationCount && blocks.size() > 1) {
+		mDevice.freeMemory(block.mMemory);
+		mMemoryAllocatorStatistics.blockCount--;
+		mMemoryAllocatorStatistics.allocatedBytes -= block.mSize;
+		blocks.erase(std::find_if(blocks.begin(), blocks.end(), [&block](const auto& candidate) { return candidate.get() == &block; }));
+	}
 }
 
-VkMemoryAllocateInfo vklCreateMemoryAllocateInfo(VkDeviceSize bufferSize, VkMemoryRequirements memoryRequirements, VkMemoryPropertyFlags memoryPropertyFlags) {
-  return static_cast<VkMemoryAllocateInfo>(vklCreateMemoryAllocateInfo(static_cast<vk::DeviceSize>(bufferSize), static_cast<vk::MemoryRequirements>(memoryRequirements), static_cast<vk::MemoryPropertyFlags>(memoryPropertyFlags)));
+// Returns the allocation of the built-in memory allocator which backs a resource, or nullptr if VMA has allocated it:
+VklMemoryAllocation* getMemoryAllocation(VklBackingMemory& backing_memory)
+{
+#ifdef VKL_HAS_VMA
+	return std::get_if<VklMemoryAllocation>(&backing_memory);
+#else
+	return &backing_memory;
+#endif
 }
 
-VkDeviceMemory vklAllocateMemoryForGivenRequirements(VkDeviceSize bufferSize, VkMemoryRequirements memoryRequirements, VkMemoryPropertyFlags memoryPropertyFlags)
+// Frees all memory of the built-in memory allocator, including the memory of resources which have not been destroyed:
+void destroyMemoryAllocator()
 {
-    const auto memoryAllocInfo = vklCreateMemoryAllocateInfo(bufferSize, memoryRequirements, memoryPropertyFlags);
+	auto forgetResources = [](auto& resourcesWithBackingMemory) {
+		for (auto it = resourcesWithBackingMemory.begin(); it != resourcesWithBackingMemory.end();) {
+			auto* allocation = getMemoryAllocation(it->second);
+			if (nullptr == allocation) {
+				++it;
+				continue;
+			}
+			if (nullptr == allocation->mBlock) {
+				mDevice.freeMemory(allocation->mMemory);
+			}
+			it = resourcesWithBackingMemory.erase(it);
+		}
+	};
+	forgetResources(mHostCoherentBuffersWithBackingMemory);
+	forgetResources(mDeviceLocalBuffersWithBackingMemory);
+	forgetResources(mImagesWithBackingMemory);
 
-	// Allocate:
-	VkDeviceMemory memory;
-    VkResult returnCode = vkAllocateMemory(static_cast<VkDevice>(mDevice), &memoryAllocInfo, NULL, &memory);
-	if (returnCode == VK_SUCCESS) {
-		return memory;
+	if (mMemoryAllocatorStatistics.subAllocationCount + mMemoryAllocatorStatistics.dedicatedAllocationCount > 0) {
+		VKL_WARNING(mMemoryAllocatorStatistics.subAllocationCount + mMemoryAllocatorStatistics.dedicatedAllocationCount << " buffer(s) or image(s) have not been destroyed before vklDestroyFramework. Their memory is freed anyways.");
 	}
-	else {
-    	VKL_EXIT_WITH_ERROR(std::string("Error allocating memory of size [") + std::to_string(bufferSize) + "] and requirements[" + std::to_string(memoryRequirements.alignment) + ", " + std::to_string(memoryRequirements.memoryTypeBits) + ", " + std::to_string(memoryRequirements.size) + "]\n    Error Code: " + to_string(returnCode));
+	for (auto& blocks : mMemoryBlocks) {
+		for (auto& block : blocks.second) {
+			mDevice.freeMemory(block->mMemory);
+		}
 	}
+	mMemoryBlocks.clear();
+	mMemoryAllocatorStatistics = {};
 }
 
-vk::UniqueDeviceMemory vklAllocateMemoryForGivenRequirements(vk::DeviceSize bufferSize, vk::MemoryRequirements memoryRequirements, vk::MemoryPropertyFlags memoryPropertyFlags) {
-  const auto memoryAllocInfo = vklCreateMemoryAllocateInfo(bufferSize, memoryRequirements, memoryPropertyFlags);
-  auto allocatedMemory = mDevice.allocateMemoryUnique(memoryAllocInfo, nullptr, mDispatchLoader);
-  return allocatedMemory;
+void vklConfigureMemoryAllocator(const VklMemoryAllocatorConfig& config)
+{
+	if (0 == config.blockSizeInBytes) {
+		VKL_EXIT_WITH_ERROR("The block size of the memory allocator must not be 0.");
+	}
+	mMemoryAllocatorConfig = config;
 }
 
-VkBuffer vklCreateHostCoherentBufferWithBackingMemory(VkDeviceSize buffer_size, VkBufferUsageFlags buffer_usage)
+VklMemoryAllocatorStatistics vklGetMemoryAllocatorStatistics()
+{
+	return mMemoryAllocatorStatistics;
+}
+
+// Creates a host-coherent buffer like vklCreateHostCoherentBufferWithBackingMemory does, but lets the framework's own buffers ask for
+// additional memory properties, e.g., uniform buffers preferring memory which is also device-local:
+VkBuffer createHostCoherentBuffer(VkDeviceSize buffer_size, VkBufferUsageFlags buffer_usage, vk::MemoryPropertyFlags preferred_flags)
 {
 	if (!vklFrameworkInitialized()) {
 		VKL_EXIT_WITH_ERROR("Framework not initialized. Ensure to invoke vklInitFramework beforehand!");
@@ -821,6 +3658,8 @@ VkBuffer vklCreateHostCoherentBufferWithBackingMemory(VkDeviceSize buffer_size,
 		VmaAllocationCreateInfo vmaBufferCreateInfo = {};
 		vmaBufferCreateInfo.usage = VMA_MEMORY_USAGE_UNKNOWN;
 		vmaBufferCreateInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+		vmaBufferCreateInfo.preferredFlags = static_cast<VkMemoryPropertyFlags>(preferred_flags);
+		vmaBufferCreateInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT; // Keep it mapped for vklGetMappedPointer and vklCopyDataIntoHostCoherentBuffer
 		VkBuffer bufferFromVma;
 		VmaAllocation vmaAllocation;
 		vmaCreateBuffer(mVmaAllocator, &static_cast<const VkBufferCreateInfo&>(createInfo), &vmaBufferCreateInfo, &bufferFromVma, &vmaAllocation, nullptr);
@@ -832,18 +3671,22 @@ VkBuffer vklCreateHostCoherentBufferWithBackingMemory(VkDeviceSize buffer_size,
 	auto buffer = mDevice.createBuffer(createInfo);
 
 	// Allocate the memory (we want host-coherent memory):
-    auto memory = vklAllocateMemoryForGivenRequirements(static_cast<vk::DeviceSize>(buffer_size), mDevice.getBufferMemoryRequirements(buffer), vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
-    
+	auto memory = allocateResourceMemory(mDevice.getBufferMemoryRequirements(buffer), vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent, preferred_flags, /* optimal_image: */ false);
+
 	// Bind the buffer handle to the memory:
-	// mDevice.bindBufferMemory(buffer, memory.get(), 0);
-	mDevice.bindBufferMemory(buffer, memory.get(), 0);
+	mDevice.bindBufferMemory(buffer, memory.mMemory, memory.mOffset);
 
 	// Remember the assignment:
-	mHostCoherentBuffersWithBackingMemory[static_cast<VkBuffer>(buffer)] = std::move(memory);
+	mHostCoherentBuffersWithBackingMemory[static_cast<VkBuffer>(buffer)] = memory;
 
 	return static_cast<VkBuffer>(buffer);
 }
 
+VkBuffer vklCreateHostCoherentBufferWithBackingMemory(VkDeviceSize buffer_size, VkBufferUsageFlags buffer_usage)
+{
+	return createHostCoherentBuffer(buffer_size, buffer_usage, vk::MemoryPropertyFlags{});
+}
+
 VkBuffer vklCreateDeviceLocalBufferWithBackingMemory(VkDeviceSize buffer_size, VkBufferUsageFlags buffer_usage)
 {
 	if (!vklFrameworkInitialized()) {
@@ -871,14 +3714,13 @@ VkBuffer vklCreateDeviceLocalBufferWithBackingMemory(VkDeviceSize buffer_size, V
 	auto buffer = mDevice.createBuffer(createInfo);
 
 	// Allocate the memory (we want device-local memory):
-	auto memory = vklAllocateMemoryForGivenRequirements(static_cast<vk::DeviceSize>(buffer_size), mDevice.getBufferMemoryRequirements(buffer), vk::MemoryPropertyFlagBits::eDeviceLocal);
+	auto memory = allocateResourceMemory(mDevice.getBufferMemoryRequirements(buffer), vk::MemoryPropertyFlagBits::eDeviceLocal, vk::MemoryPropertyFlags{}, /* optimal_image: */ false);
 
 	// Bind the buffer handle to the memory:
-	// mDevice.bindBufferMemory(buffer, memory.get(), 0);
-	mDevice.bindBufferMemory(buffer, memory.get(), 0);
+	mDevice.bindBufferMemory(buffer, memory.mMemory, memory.mOffset);
 
 	// Remember the assignment:
-	mDeviceLocalBuffersWithBackingMemory[static_cast<VkBuffer>(buffer)] = std::move(memory);
+	mDeviceLocalBuffersWithBackingMemory[static_cast<VkBuffer>(buffer)] = memory;
 
 	return static_cast<VkBuffer>(buffer);
 }
@@ -895,12 +3737,18 @@ void vklDestroyHostCoherentBufferAndItsBackingMemory(VkBuffer buffer)
 	bool resourceDestroyed = false;
 	auto search = mHostCoherentBuffersWithBackingMemory.find(buffer);
 	if (mHostCoherentBuffersWithBackingMemory.end() != search) {
+		auto* allocation = getMemoryAllocation(search->second);
+		if (nullptr != allocation) {
+			// Destroy the buffer before its memory is returned to the allocator:
+			mDevice.destroy(vk::Buffer{ buffer });
+			freeResourceMemory(*allocation);
+		}
 #ifdef VKL_HAS_VMA
-		if (vklHasVmaAllocator() && std::holds_alternative<VmaAllocation>(search->second)) {
+		else {
 			vmaDestroyBuffer(mVmaAllocator, buffer, std::get<VmaAllocation>(search->second));
-			resourceDestroyed = true;
 		}
 #endif
+		resourceDestroyed = true;
 		mHostCoherentBuffersWithBackingMemory.erase(search);
 	}
 	else {
@@ -921,15 +3769,26 @@ void vklDestroyDeviceLocalBufferAndItsBackingMemory(VkBuffer buffer)
 		VKL_EXIT_WITH_ERROR("Invalid buffer handle passed to vklDestroyDeviceLocalBufferAndItsBackingMemory(...)");
 	}
 
+	// Uploads which have not been submitted yet must not write into the destroyed buffer:
+	mPendingStagedCopies.erase(std::remove_if(mPendingStagedCopies.begin(), mPendingStagedCopies.end(), [buffer](const VklStagedCopy& copy) {
+		return copy.mDstBuffer == vk::Buffer{ buffer };
+	}), mPendingStagedCopies.end());
+
 	bool resourceDestroyed = false;
 	auto search = mDeviceLocalBuffersWithBackingMemory.find(buffer);
 	if (mDeviceLocalBuffersWithBackingMemory.end() != search) {
+		auto* allocation = getMemoryAllocation(search->second);
+		if (nullptr != allocation) {
+			// Destroy the buffer before its memory is returned to the allocator:
+			mDevice.destroy(vk::Buffer{ buffer });
+			freeResourceMemory(*allocation);
+		}
 #ifdef VKL_HAS_VMA
-		if (vklHasVmaAllocator() && std::holds_alternative<VmaAllocation>(search->second)) {
+		else {
 			vmaDestroyBuffer(mVmaAllocator, buffer, std::get<VmaAllocation>(search->second));
-			resourceDestroyed = true;
 		}
 #endif
+		resourceDestroyed = true;
 		mDeviceLocalBuffersWithBackingMemory.erase(search);
 	}
 	else {
@@ -946,40 +3805,65 @@ void vklCopyDataIntoHostCoherentBuffer(VkBuffer buffer, const void* data_pointer
 	vklCopyDataIntoHostCoherentBuffer(buffer, 0, data_pointer, data_size_in_bytes);
 }
 
-void vklCopyDataIntoHostCoherentBuffer(VkBuffer buffer, size_t buffer_offset_in_bytes, const void* data_pointer, size_t data_size_in_bytes)
+// Returns the persistently mapped memory of a buffer created with vklCreateHostCoherentBufferWithBackingMemory, and the size of the mapped range:
+uint8_t* getMappedHostCoherentMemory(VkBuffer buffer, vk::DeviceSize& out_size)
+{
+	auto search = mHostCoherentBuffersWithBackingMemory.find(buffer);
+	if (mHostCoherentBuffersWithBackingMemory.end() == search) {
+		VKL_EXIT_WITH_ERROR("Couldn't find backing memory for the given VkBuffer. Have you created the buffer via vklCreateHostCoherentBufferWithBackingMemory(...)?");
+	}
+
+	auto* allocation = getMemoryAllocation(search->second);
+	if (nullptr != allocation) {
+		out_size = allocation->mSize;
+		return allocation->mMappedData;
+	}
+#ifdef VKL_HAS_VMA
+	VmaAllocationInfo allocationInfo;
+	vmaGetAllocationInfo(mVmaAllocator, std::get<VmaAllocation>(search->second), &allocationInfo);
+	out_size = allocationInfo.size;
+	return static_cast<uint8_t*>(allocationInfo.pMappedData);
+#else
+	return nullptr;
+#endif
+}
+
+void* vklGetMappedPointer(VkBuffer buffer)
 {
 	if (!vklFrameworkInitialized()) {
 		VKL_EXIT_WITH_ERROR("Framework not initialized. Ensure to invoke vklInitFramework beforehand!");
 	}
 	if (VkBuffer{} == buffer) {
-		VKL_EXIT_WITH_ERROR("Invalid buffer handle passed to vklCopyDataIntoHostCoherentBuffer(...)");
+		VKL_EXIT_WITH_ERROR("Invalid buffer handle passed to vklGetMappedPointer(...)");
 	}
 
-	auto search = mHostCoherentBuffersWithBackingMemory.find(buffer);
-	if (mHostCoherentBuffersWithBackingMemory.end() == search) {
-		VKL_EXIT_WITH_ERROR("Couldn't find backing memory for the given VkBuffer => Can't copy data. Have you created the buffer via vklCreateHostCoherentBufferWithBackingMemory(...)?");
-	}
+	vk::DeviceSize mappedSize;
+	return getMappedHostCoherentMemory(buffer, mappedSize);
+}
 
-#ifdef VKL_HAS_VMA
-	if (vklHasVmaAllocator() && std::holds_alternative<VmaAllocation>(search->second)) {
-		void* mappedData;
-		auto result = vmaMapMemory(mVmaAllocator, std::get<VmaAllocation>(search->second), &mappedData);
-		assert(result >= 0);
-		memcpy(mappedData, data_pointer, data_size_in_bytes);
-		vmaUnmapMemory(mVmaAllocator, std::get<VmaAllocation>(search->second));
+void vklCopyDataIntoHostCoherentBuffer(VkBuffer buffer, size_t buffer_offset_in_bytes, const void* data_pointer, size_t data_size_in_bytes)
+{
+	vklCopyDataIntoHostCoherentBuffer(buffer, { VklBufferCopyRange{ buffer_offset_in_bytes, data_pointer, data_size_in_bytes } });
+}
+
+void vklCopyDataIntoHostCoherentBuffer(VkBuffer buffer, const std::vector<VklBufferCopyRange>& ranges)
+{
+	if (!vklFrameworkInitialized()) {
+		VKL_EXIT_WITH_ERROR("Framework not initialized. Ensure to invoke vklInitFramework beforehand!");
 	}
-	else {
-		uint8_t* mappedMemory = static_cast<uint8_t*>(mDevice.mapMemory(std::get<vk::UniqueDeviceMemory>(search->second).get(), 0, static_cast<vk::DeviceSize>(data_size_in_bytes)));
-		mappedMemory += buffer_offset_in_bytes;
-		memcpy(mappedMemory, data_pointer, data_size_in_bytes);
-		mDevice.unmapMemory(std::get<vk::UniqueDeviceMemory>(search->second).get());
+	if (VkBuffer{} == buffer) {
+		VKL_EXIT_WITH_ERROR("Invalid buffer handle passed to vklCopyDataIntoHostCoherentBuffer(...)");
+	}
+
+	// The memory of host-coherent buffers is mapped persistently, and writes to it need no flushing:
+	vk::DeviceSize mappedSize;
+	uint8_t* mappedData = getMappedHostCoherentMemory(buffer, mappedSize);
+	for (const auto& range : ranges) {
+		if (range.bufferOffsetInBytes + range.dataSizeInBytes > mappedSize) {
+			VKL_EXIT_WITH_ERROR("Can't copy " << range.dataSizeInBytes << " bytes to offset " << range.bufferOffsetInBytes << " of a buffer with " << mappedSize << " bytes of backing memory.");
+		}
+		memcpy(mappedData + range.bufferOffsetInBytes, range.dataPointer, range.dataSizeInBytes);
 	}
-#else
-	uint8_t* mappedMemory = static_cast<uint8_t*>(mDevice.mapMemory(search->second.get(), 0, static_cast<vk::DeviceSize>(data_size_in_bytes)));
-	mappedMemory += buffer_offset_in_bytes;
-	memcpy(mappedMemory, data_pointer, data_size_in_bytes);
-	mDevice.unmapMemory(search->second.get());
-#endif
 }
 
 /*!
@@ -1000,6 +3884,499 @@ VkBuffer vklCreateHostCoherentBufferAndUploadData(const void* data, size_t size,
     return result;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Staging ring for uploads into device-local buffers
+
+constexpr vk::DeviceSize STAGING_RING_ALIGNMENT = 16;
+
+// Records all pending staged copies into a new command buffer, which must be submitted before any work that reads the
+// uploaded data. Copies into the same buffer are recorded with one vkCmdCopyBuffer. The acquire barriers of asynchronous
+// uploads are recorded into the same command buffer. Returns an empty handle if there is nothing to record.
+vk::UniqueCommandBuffer recordUploadCommands(const std::vector<vk::BufferMemoryBarrier>& buffer_acquire_barriers = {}, const std::vector<vk::ImageMemoryBarrier>& image_acquire_barriers = {})
+{
+	if (mPendingStagedCopies.empty() && buffer_acquire_barriers.empty() && image_acquire_barriers.empty()) {
+		return {};
+	}
+
+	auto tmp = mDevice.allocateCommandBuffersUnique(vk::CommandBufferAllocateInfo{
+			mCommandPool.get(),
+			vk::CommandBufferLevel::ePrimary,
+			1u
+		},
+		mDispatchLoader
+	);
+	assert(!tmp.empty());
+	auto cb = std::move(tmp[0]);
+	cb->begin(vk::CommandBufferBeginInfo{ vk::CommandBufferUsageFlagBits::eOneTimeSubmit });
+
+	// Don't overwrite data which previously submitted work might still be reading:
+	cb->pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands, vk::PipelineStageFlagBits::eTransfer, vk::DependencyFlags{}, nullptr, nullptr, nullptr);
+
+	// Acquire the resources of asynchronous uploads from the transfer queue family (their data has been made available by the timeline semaphore):
+	if (!buffer_acquire_barriers.empty() || !image_acquire_barriers.empty()) {
+		cb->pipelineBarrier(
+			vk::PipelineStageFlagBits::eTopOfPipe,
+			vk::PipelineStageFlagBits::eTransfer | vk::PipelineStageFlagBits::eDrawIndirect | vk::PipelineStageFlagBits::eVertexInput | vk::PipelineStageFlagBits::eVertexShader | vk::PipelineStageFlagBits::eFragmentShader | vk::PipelineStageFlagBits::eComputeShader,
+			vk::DependencyFlags{}, nullptr, buffer_acquire_barriers, image_acquire_barriers);
+	}
+
+	// Group the copies by destination buffer, but keep the order of copies into the same buffer:
+	std::stable_sort(mPendingStagedCopies.begin(), mPendingStagedCopies.end(), [](const VklStagedCopy& a, const VklStagedCopy& b) {
+		return static_cast<VkBuffer>(a.mDstBuffer) < static_cast<VkBuffer>(b.mDstBuffer);
+	});
+
+	std::vector<vk::BufferCopy> regions;
+	std::map<vk::DeviceSize, vk::DeviceSize> dstRanges; // Destination ranges of regions, which must not overlap within one vkCmdCopyBuffer
+	auto recordCopy = [&](vk::Buffer dstBuffer) {
+		cb->copyBuffer(vk::Buffer{ mStagingRingBuffer }, dstBuffer, regions);
+		regions.clear();
+		dstRanges.clear();
+	};
+	for (size_t i = 0; i < mPendingStagedCopies.size(); ++i) {
+		const auto& copy = mPendingStagedCopies[i];
+		const auto dstEnd = copy.mRegion.dstOffset + copy.mRegion.size;
+
+		// A later upload into the same range must be recorded with a separate copy, after the earlier one has been written:
+		auto next = dstRanges.lower_bound(dstEnd);
+		if (dstRanges.begin() != next && std::prev(next)->second > copy.mRegion.dstOffset) {
+			recordCopy(copy.mDstBuffer);
+			cb->pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eTransfer, vk::DependencyFlags{},
+				vk::MemoryBarrier{ vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eTransferWrite }, nullptr, nullptr);
+		}
+
+		// Merge regions which are contiguous both in the ring and in the destination buffer:
+		if (!regions.empty() && regions.back().srcOffset + regions.back().size == copy.mRegion.srcOffset && regions.back().dstOffset + regions.back().size == copy.mRegion.dstOffset) {
+			regions.back().size += copy.mRegion.size;
+			dstRanges[regions.back().dstOffset] = dstEnd;
+		}
+		else {
+			regions.push_back(copy.mRegion);
+			dstRanges[copy.mRegion.dstOffset] = dstEnd;
+		}
+
+		if (i + 1 == mPendingStagedCopies.size() || mPendingStagedCopies[i + 1].mDstBuffer != copy.mDstBuffer) {
+			recordCopy(copy.mDstBuffer);
+		}
+	}
+	mPendingStagedCopies.clear();
+
+	// Make the uploaded data visible to all subsequent reads, by compute shaders as well as by rendering commands:
+	cb->pipelineBarrier(
+		vk::PipelineStageFlagBits::eTransfer,
+		vk::PipelineStageFlagBits::eDrawIndirect | vk::PipelineStageFlagBits::eVertexInput | vk::PipelineStageFlagBits::eVertexShader | vk::PipelineStageFlagBits::eFragmentShader | vk::PipelineStageFlagBits::eComputeShader,
+		vk::DependencyFlags{},
+		vk::MemoryBarrier{ vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eIndirectCommandRead | vk::AccessFlagBits::eIndexRead | vk::AccessFlagBits::eVertexAttributeRead | vk::AccessFlagBits::eUniformRead | vk::AccessFlagBits::eShaderRead },
+		nullptr, nullptr);
+	cb->end();
+	return cb;
+}
+
+// Submits all pending uploads right away, and waits until the device has finished all submitted work, which frees the whole ring.
+// This only happens if uploads do not fit into the ring, e.g., while loading lots of data before the first frame.
+void flushStagedCopiesAndWait()
+{
+	auto cb = recordUploadCommands();
+	if (cb) {
+		mQueue.submit({ vk::SubmitInfo{}.setCommandBufferCount(1u).setPCommandBuffers(&cb.get()) });
+	}
+	mQueue.waitIdle();
+	mStagingRingFrames.clear();
+	mStagingRingHead = 0;
+	mStagingRingTail = 0;
+}
+
+// Reserves the given number of bytes (at most the size of the ring) in the staging ring, and returns their offset within the ring buffer:
+vk::DeviceSize allocateStagingRange(vk::DeviceSize size)
+{
+	const auto ringSize = mStagingConfig.ringSizeInBytes;
+	auto offset = alignMemoryOffset(mStagingRingHead, STAGING_RING_ALIGNMENT);
+	if (offset % ringSize + size > ringSize) {
+		// Doesn't fit in before the end of the ring => wrap around:
+		offset = alignMemoryOffset(offset, ringSize);
+	}
+	if (offset + size - mStagingRingTail > ringSize) {
+		flushStagedCopiesAndWait();
+		offset = 0;
+	}
+	mStagingRingHead = offset + size;
+	return offset % ringSize;
+}
+
+// Frees the parts of the staging ring which have been used by the uploads of frames up to and including the given one:
+void releaseStagingRingSpace(int64_t completed_frame_id)
+{
+	while (!mStagingRingFrames.empty() && std::get<int64_t>(mStagingRingFrames.front()) <= completed_frame_id) {
+		mStagingRingTail = std::get<vk::DeviceSize>(mStagingRingFrames.front());
+		mStagingRingFrames.pop_front();
+	}
+}
+
+void destroyStagingRing()
+{
+	mPendingStagedCopies.clear();
+	mStagingRingFrames.clear();
+	mUploadCommandBuffers.clear();
+	mStagingRingHead = 0;
+	mStagingRingTail = 0;
+	if (VK_NULL_HANDLE != mStagingRingBuffer) {
+		vklDestroyHostCoherentBufferAndItsBackingMemory(mStagingRingBuffer);
+		mStagingRingBuffer = VK_NULL_HANDLE;
+		mStagingRingMappedData = nullptr;
+	}
+}
+
+void vklConfigureStaging(const VklStagingConfig& config)
+{
+	if (0 == config.ringSizeInBytes) {
+		VKL_EXIT_WITH_ERROR("The size of the staging ring must not be 0.");
+	}
+	if (VK_NULL_HANDLE != mStagingRingBuffer) {
+		VKL_WARNING("The staging ring has already been created. Its new size only takes effect after vklDestroyFramework.");
+	}
+	mStagingConfig = config;
+}
+
+void vklUploadToDeviceLocalBuffer(VkBuffer dst_buffer, VkDeviceSize dst_offset_in_bytes, const void* data_pointer, VkDeviceSize data_size_in_bytes)
+{
+	if (!vklFrameworkInitialized()) {
+		VKL_EXIT_WITH_ERROR("Framework not initialized. Ensure to invoke vklInitFramework beforehand!");
+	}
+	if (VkBuffer{} == dst_buffer) {
+		VKL_EXIT_WITH_ERROR("Invalid buffer handle passed to vklUploadToDeviceLocalBuffer(...)");
+	}
+
+	// The ring is created on first use:
+	if (VK_NULL_HANDLE == mStagingRingBuffer) {
+		mStagingRingBuffer = vklCreateHostCoherentBufferWithBackingMemory(mStagingConfig.ringSizeInBytes, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+		mStagingRingMappedData = static_cast<uint8_t*>(vklGetMappedPointer(mStagingRingBuffer));
+	}
+
+	// Data which is larger than the ring is uploaded in multiple parts:
+	const auto* src = static_cast<const uint8_t*>(data_pointer);
+	while (data_size_in_bytes > 0) {
+		const auto partSize = std::min(static_cast<vk::DeviceSize>(data_size_in_bytes), mStagingConfig.ringSizeInBytes);
+		const auto stagingOffset = allocateStagingRange(partSize);
+		memcpy(mStagingRingMappedData + stagingOffset, src, static_cast<size_t>(partSize));
+		mPendingStagedCopies.push_back(VklStagedCopy{ vk::Buffer{ dst_buffer }, vk::BufferCopy{ stagingOffset, dst_offset_in_bytes, partSize } });
+		src += partSize;
+		dst_offset_in_bytes += partSize;
+		data_size_in_bytes -= partSize;
+	}
+}
+
+VkBuffer vklCreateDeviceLocalBufferAndUploadData(const void* data, size_t size, VkBufferUsageFlags usageFlags) {
+	VkBuffer result = vklCreateDeviceLocalBufferWithBackingMemory(
+			static_cast<VkDeviceSize>(size),
+			VK_BUFFER_USAGE_TRANSFER_DST_BIT | usageFlags
+	);
+	vklUploadToDeviceLocalBuffer(result, 0, data, static_cast<VkDeviceSize>(size));
+	return result;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Asynchronous uploads on the transfer queue
+
+vk::Queue getTransferQueue()
+{
+	return VK_NULL_HANDLE != mTransferQueueConfig.transferQueue ? vk::Queue{ mTransferQueueConfig.transferQueue } : mQueue;
+}
+
+// Resources have to be transferred from the transfer queue family to the graphics queue family only if these differ:
+bool asyncUploadsTransferOwnership()
+{
+	return VK_NULL_HANDLE != mTransferQueueConfig.transferQueue && mTransferQueueConfig.transferQueueFamilyIndex != mTransferQueueConfig.graphicsQueueFamilyIndex;
+}
+
+// Returns the value which the upload timeline semaphore has reached, i.e., the token of the last completed upload.
+uint64_t getCompletedUploadTimelineValue()
+{
+	return mUseTimelineSemaphoreKHR
+		? mDevice.getSemaphoreCounterValueKHR(mUploadTimelineSemaphore.get(), mDynamicDispatch)
+		: mDevice.getSemaphoreCounterValue(mUploadTimelineSemaphore.get(), mDynamicDispatch);
+}
+
+// Copies the data into a new staging buffer, and starts recording the upload's command buffer.
+VklAsyncUpload beginAsyncUpload(const void* data_pointer, VkDeviceSize data_size_in_bytes)
+{
+	// The timeline semaphore and the command pool are created on first use:
+	if (!mUploadTimelineSemaphore) {
+		// Which commands are available depends on the API version and the extensions which the application has created the device with,
+		// not on the physical device's API version. Hence, load them, and prefer the extension's commands if it has been enabled:
+		mDynamicDispatch.init(mDevice);
+		mUseTimelineSemaphoreKHR = nullptr != mDynamicDispatch.vkGetSemaphoreCounterValueKHR && nullptr != mDynamicDispatch.vkWaitSemaphoresKHR;
+		if (!mUseTimelineSemaphoreKHR && (nullptr == mDynamicDispatch.vkGetSemaphoreCounterValue || nullptr == mDynamicDispatch.vkWaitSemaphores)) {
+			VKL_EXIT_WITH_ERROR("Asynchronous uploads require timeline semaphores. Create the device with Vulkan 1.2, or enable the VK_KHR_timeline_semaphore extension.");
+		}
+		auto typeCreateInfo = vk::SemaphoreTypeCreateInfo{ vk::SemaphoreType::eTimeline, mLastUploadTimelineValue };
+		mUploadTimelineSemaphore = mDevice.createSemaphoreUnique(vk::SemaphoreCreateInfo{}.setPNext(&typeCreateInfo), nullptr, mDispatchLoader);
+		const auto queueFamilyIndex = VK_NULL_HANDLE != mTransferQueueConfig.transferQueue ? mTransferQueueConfig.transferQueueFamilyIndex : mTransferQueueConfig.graphicsQueueFamilyIndex;
+		mTransferCommandPool = mDevice.createCommandPoolUnique(vk::CommandPoolCreateInfo{ vk::CommandPoolCreateFlagBits::eTransient, queueFamilyIndex }, nullptr, mDispatchLoader);
+	}
+
+	VklAsyncUpload upload;
+	upload.mStagingBuffer = vklCreateHostCoherentBufferWithBackingMemory(data_size_in_bytes, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+	memcpy(vklGetMappedPointer(upload.mStagingBuffer), data_pointer, static_cast<size_t>(data_size_in_bytes));
+
+	auto tmp = mDevice.allocateCommandBuffersUnique(vk::CommandBufferAllocateInfo{
+			mTransferCommandPool.get(),
+			vk::CommandBufferLevel::ePrimary,
+			1u
+		},
+		mDispatchLoader
+	);
+	assert(!tmp.empty());
+	upload.mCommandBuffer = std::move(tmp[0]);
+	upload.mCommandBuffer->begin(vk::CommandBufferBeginInfo{ vk::CommandBufferUsageFlagBits::eOneTimeSubmit });
+	return upload;
+}
+
+// Submits the upload's command buffer to the transfer queue, and returns the timeline value which it signals.
+VklUploadToken submitAsyncUpload(VklAsyncUpload&& upload)
+{
+	upload.mCommandBuffer->end();
+	upload.mTimelineValue = ++mLastUploadTimelineValue;
+
+	auto timelineSubmitInfo = vk::TimelineSemaphoreSubmitInfo{}
+		.setSignalSemaphoreValueCount(1u)
+		.setPSignalSemaphoreValues(&upload.mTimelineValue);
+	getTransferQueue().submit({ vk::SubmitInfo{}
+		.setPNext(&timelineSubmitInfo)
+		.setCommandBufferCount(1u)
+		.setPCommandBuffers(&upload.mCommandBuffer.get())
+		.setSignalSemaphoreCount(1u)
+		.setPSignalSemaphores(&mUploadTimelineSemaphore.get())
+	});
+
+	const auto token = upload.mTimelineValue;
+	mAsyncUploads.push_back(std::move(upload));
+	return token;
+}
+
+// Destroys the staging buffers and command buffers of asynchronous uploads which have completed and have been acquired.
+void collectFinishedAsyncUploads()
+{
+	if (mAsyncUploads.empty()) {
+		return;
+	}
+	const auto completedValue = std::min(getCompletedUploadTimelineValue(), mAcquiredUploadTimelineValue);
+	while (!mAsyncUploads.empty() && mAsyncUploads.front().mTimelineValue <= completedValue) {
+		vklDestroyHostCoherentBufferAndItsBackingMemory(mAsyncUploads.front().mStagingBuffer);
+		mAsyncUploads.pop_front();
+	}
+}
+
+void destroyAsyncUploads()
+{
+	for (auto& upload : mAsyncUploads) {
+		vklDestroyHostCoherentBufferAndItsBackingMemory(upload.mStagingBuffer);
+	}
+	mAsyncUploads.clear();
+	mTransferCommandPool.reset();
+	mUploadTimelineSemaphore.reset();
+	mLastUploadTimelineValue = 0;
+	mAcquiredUploadTimelineValue = 0;
+	mUploadTimelineValueToWaitFor = 0;
+}
+
+void vklConfigureTransferQueue(const VklTransferQueueConfig& config)
+{
+	if (mUploadTimelineSemaphore) {
+		VKL_WARNING("Asynchronous uploads have already been submitted. The transfer queue config only takes effect after vklDestroyFramework.");
+		return;
+	}
+	mTransferQueueConfig = config;
+}
+
+VklUploadToken vklUploadToDeviceLocalBufferAsync(VkBuffer dst_buffer, VkDeviceSize dst_offset_in_bytes, const void* data_pointer, VkDeviceSize data_size_in_bytes)
+{
+	if (!vklFrameworkInitialized()) {
+		VKL_EXIT_WITH_ERROR("Framework not initialized. Ensure to invoke vklInitFramework beforehand!");
+	}
+	if (VkBuffer{} == dst_buffer) {
+		VKL_EXIT_WITH_ERROR("Invalid buffer handle passed to vklUploadToDeviceLocalBufferAsync(...)");
+	}
+
+	auto upload = beginAsyncUpload(data_pointer, data_size_in_bytes);
+	upload.mCommandBuffer->copyBuffer(vk::Buffer{ upload.mStagingBuffer }, vk::Buffer{ dst_buffer }, vk::BufferCopy{ 0, dst_offset_in_bytes, data_size_in_bytes });
+
+	if (asyncUploadsTransferOwnership()) {
+		// Release the buffer range to the graphics queue family, which acquires it with an identical barrier:
+		auto barrier = vk::BufferMemoryBarrier{}
+			.setSrcAccessMask(vk::AccessFlagBits::eTransferWrite)
+			.setSrcQueueFamilyIndex(mTransferQueueConfig.transferQueueFamilyIndex)
+			.setDstQueueFamilyIndex(mTransferQueueConfig.graphicsQueueFamilyIndex)
+			.setBuffer(vk::Buffer{ dst_buffer })
+			.setOffset(dst_offset_in_bytes)
+			.setSize(data_size_in_bytes);
+		upload.mCommandBuffer->pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eBottomOfPipe, vk::DependencyFlags{}, nullptr, barrier, nullptr);
+		upload.mBufferAcquireBarriers.push_back(barrier
+			.setSrcAccessMask(vk::AccessFlags{})
+			.setDstAccessMask(vk::AccessFlagBits::eTransferWrite | vk::AccessFlagBits::eIndirectCommandRead | vk::AccessFlagBits::eIndexRead | vk::AccessFlagBits::eVertexAttributeRead | vk::AccessFlagBits::eUniformRead | vk::AccessFlagBits::eShaderRead));
+	}
+
+	return submitAsyncUpload(std::move(upload));
+}
+
+VklUploadToken vklUploadToDeviceLocalImageAsync(VkImage dst_image, uint32_t width, uint32_t height, uint32_t mip_level, uint32_t array_layer, const void* data_pointer, VkDeviceSize data_size_in_bytes)
+{
+	if (!vklFrameworkInitialized()) {
+		VKL_EXIT_WITH_ERROR("Framework not initialized. Ensure to invoke vklInitFramework beforehand!");
+	}
+	if (VkImage{} == dst_image) {
+		VKL_EXIT_WITH_ERROR("Invalid image handle passed to vklUploadToDeviceLocalImageAsync(...)");
+	}
+
+	auto upload = beginAsyncUpload(data_pointer, data_size_in_bytes);
+	const auto subresourceRange = vk::ImageSubresourceRange{ vk::ImageAspectFlagBits::eColor, mip_level, 1u, array_layer, 1u };
+
+	// The previous contents of the subresource are discarded:
+	upload.mCommandBuffer->pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eTransfer, vk::DependencyFlags{}, nullptr, nullptr,
+		vk::ImageMemoryBarrier{}
+			.setDstAccessMask(vk::AccessFlagBits::eTransferWrite)
+			.setOldLayout(vk::ImageLayout::eUndefined)
+			.setNewLayout(vk::ImageLayout::eTransferDstOptimal)
+			.setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+			.setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+			.setImage(vk::Image{ dst_image })
+			.setSubresourceRange(subresourceRange));
+	upload.mCommandBuffer->copyBufferToImage(vk::Buffer{ upload.mStagingBuffer }, vk::Image{ dst_image }, vk::ImageLayout::eTransferDstOptimal,
+		vk::BufferImageCopy{ 0, 0u, 0u, vk::ImageSubresourceLayers{ vk::ImageAspectFlagBits::eColor, mip_level, array_layer, 1u }, vk::Offset3D{ 0, 0, 0 }, vk::Extent3D{ width, height, 1u } });
+
+	// Transition the subresource for sampling, and release it to the graphics queue family if it differs (the acquire barrier must specify the same layouts):
+	const bool transferOwnership = asyncUploadsTransferOwnership();
+	auto barrier = vk::ImageMemoryBarrier{}
+		.setSrcAccessMask(vk::AccessFlagBits::eTransferWrite)
+		.setOldLayout(vk::ImageLayout::eTransferDstOptimal)
+		.setNewLayout(vk::ImageLayout::eShaderReadOnlyOptimal)
+		.setSrcQueueFamilyIndex(transferOwnership ? mTransferQueueConfig.transferQueueFamilyIndex : VK_QUEUE_FAMILY_IGNORED)
+		.setDstQueueFamilyIndex(transferOwnership ? mTransferQueueConfig.graphicsQueueFamilyIndex : VK_QUEUE_FAMILY_IGNORED)
+		.setImage(vk::Image{ dst_image })
+		.setSubresourceRange(subresourceRange);
+	upload.mCommandBuffer->pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eBottomOfPipe, vk::DependencyFlags{}, nullptr, nullptr, barrier);
+	if (transferOwnership) {
+		upload.mImageAcquireBarriers.push_back(barrier
+			.setSrcAccessMask(vk::AccessFlags{})
+			.setDstAccessMask(vk::AccessFlagBits::eShaderRead));
+	}
+
+	return submitAsyncUpload(std::move(upload));
+}
+
+bool vklIsUploadComplete(VklUploadToken token)
+{
+	if (!vklFrameworkInitialized()) {
+		VKL_EXIT_WITH_ERROR("Framework not initialized. Ensure to invoke vklInitFramework beforehand!");
+	}
+	return !mUploadTimelineSemaphore || getCompletedUploadTimelineValue() >= token;
+}
+
+void vklWaitForUpload(VklUploadToken token)
+{
+	if (!vklFrameworkInitialized()) {
+		VKL_EXIT_WITH_ERROR("Framework not initialized. Ensure to invoke vklInitFramework beforehand!");
+	}
+	if (!mUploadTimelineSemaphore) {
+		return;
+	}
+	const auto semaphore = mUploadTimelineSemaphore.get();
+	const auto waitInfo = vk::SemaphoreWaitInfo{}.setSemaphoreCount(1u).setPSemaphores(&semaphore).setPValues(&token);
+	vk::Result returnCode = mUseTimelineSemaphoreKHR
+		? mDevice.waitSemaphoresKHR(waitInfo, std::numeric_limits<uint64_t>::max(), mDynamicDispatch)
+		: mDevice.waitSemaphores(waitInfo, std::numeric_limits<uint64_t>::max(), mDynamicDispatch);
+	VKL_CHECK_VULKAN_ERROR(static_cast<VkResult>(returnCode));
+}
+
+void vklWaitForUploadInCurrentFrame(VklUploadToken token)
+{
+	if (!vklFrameworkInitialized()) {
+		VKL_EXIT_WITH_ERROR("Framework not initialized. Ensure to invoke vklInitFramework beforehand!");
+	}
+	if (token > mLastUploadTimelineValue) {
+		VKL_EXIT_WITH_ERROR("Invalid token passed to vklWaitForUploadInCurrentFrame(...). It has not been returned by any asynchronous upload.");
+	}
+	mUploadTimelineValueToWaitFor = std::max(mUploadTimelineValueToWaitFor, token);
+}
+
+VkSemaphore vklGetUploadTimelineSemaphore()
+{
+	return static_cast<VkSemaphore>(mUploadTimelineSemaphore.get());
+}
+
+// ------------------------------------------------------------------------------------------------
+// Per-frame linear allocator for transient uniform data
+
+// Creates the uniform buffer on first use, with one region per frame in flight, each starting at an aligned offset:
+void createUniformBufferIfNeeded()
+{
+	if (VK_NULL_HANDLE != mUniformBuffer) {
+		return;
+	}
+	mUniformBufferAlignment = std::max(mPhysicalDevice.getProperties().limits.minUniformBufferOffsetAlignment, vk::DeviceSize{ 1 });
+	mUniformBufferRegionSize = alignMemoryOffset(mUniformAllocatorConfig.bytesPerFrame, mUniformBufferAlignment);
+	// The GPU reads uniform data every frame, while the host writes it only once => prefer the device-local part of host-visible memory where
+	// there is one. The staging ring, in contrast, is only read once by copies and must not take up this (often small) heap.
+	mUniformBuffer = createHostCoherentBuffer(mUniformBufferRegionSize * CONCURRENT_FRAMES, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, vk::MemoryPropertyFlagBits::eDeviceLocal);
+	mUniformBufferMappedData = static_cast<uint8_t*>(vklGetMappedPointer(mUniformBuffer));
+	mUniformBufferHeads.fill(0);
+}
+
+void destroyUniformAllocator()
+{
+	if (VK_NULL_HANDLE != mUniformBuffer) {
+		vklDestroyHostCoherentBufferAndItsBackingMemory(mUniformBuffer);
+		mUniformBuffer = VK_NULL_HANDLE;
+		mUniformBufferMappedData = nullptr;
+	}
+}
+
+void vklConfigureUniformAllocator(const VklUniformAllocatorConfig& config)
+{
+	if (0 == config.bytesPerFrame) {
+		VKL_EXIT_WITH_ERROR("The size of the uniform allocator's per-frame regions must not be 0.");
+	}
+	if (VK_NULL_HANDLE != mUniformBuffer) {
+		VKL_WARNING("The uniform allocator's buffer has already been created. Its new size only takes effect after vklDestroyFramework.");
+	}
+	mUniformAllocatorConfig = config;
+}
+
+VkBuffer vklGetUniformAllocatorBuffer()
+{
+	if (!vklFrameworkInitialized()) {
+		VKL_EXIT_WITH_ERROR("Framework not initialized. Ensure to invoke vklInitFramework beforehand!");
+	}
+	createUniformBufferIfNeeded();
+	return mUniformBuffer;
+}
+
+VklUniformAllocation vklAllocateUniformData(VkDeviceSize size_in_bytes, const void* data_pointer)
+{
+	if (!vklFrameworkInitialized()) {
+		VKL_EXIT_WITH_ERROR("Framework not initialized. Ensure to invoke vklInitFramework beforehand!");
+	}
+	if (mFrameId < 0) {
+		VKL_EXIT_WITH_ERROR("Uniform data can only be allocated for a frame, i.e., after vklWaitForNextSwapchainImage has been called.");
+	}
+	createUniformBufferIfNeeded();
+
+	auto& head = mUniformBufferHeads[mFrameInFlightIndex];
+	const auto offset = alignMemoryOffset(head, mUniformBufferAlignment);
+	if (offset + size_in_bytes > mUniformBufferRegionSize) {
+		VKL_EXIT_WITH_ERROR("The uniform allocator's region of " << mUniformBufferRegionSize << " bytes is exhausted for this frame. Increase VklUniformAllocatorConfig::bytesPerFrame via vklConfigureUniformAllocator.");
+	}
+	head = offset + size_in_bytes;
+
+	const auto bufferOffset = mUniformBufferRegionSize * mFrameInFlightIndex + offset;
+	VklUniformAllocation allocation;
+	allocation.buffer = mUniformBuffer;
+	allocation.offset = bufferOffset;
+	allocation.mappedPointer = mUniformBufferMappedData + bufferOffset;
+	if (nullptr != data_pointer) {
+		memcpy(allocation.mappedPointer, data_pointer, static_cast<size_t>(size_in_bytes));
+	}
+	return allocation;
+}
+
 const char* vklRequiredInstanceExtensions[] = {
 	VK_EXT_DEBUG_UTILS_EXTENSION_NAME
 };
@@ -1010,43 +4387,88 @@ const char** vklGetRequiredInstanceExtensions(uint32_t* out_count)
 	return vklRequiredInstanceExtensions;
 }
 
+// Returns the compute command buffer of the current frame, and starts recording it if it has not been started in this frame yet.
+vk::CommandBuffer getCurrentComputeCommandBuffer()
+{
+	if (mComputeCommandBufferRecording) {
+		return mComputeCommandBuffers.back().get();
+	}
+
+	// Clean up old command buffers, just like vklStartRecordingCommands does:
+	const auto numToKeep = static_cast<size_t>(std::max(static_cast<int>(mSwapchainImageViews.size()), int{ CONCURRENT_FRAMES }));
+	while (mComputeCommandBuffers.size() > numToKeep) {
+		mComputeCommandBuffers.pop_front();
+	}
+
+	auto tmp = mDevice.allocateCommandBuffersUnique(vk::CommandBufferAllocateInfo{
+			mCommandPool.get(),
+			vk::CommandBufferLevel::ePrimary,
+			1u
+		}, 
+		mDispatchLoader
+	);
+	assert(!tmp.empty());
+	mComputeCommandBuffers.push_back(std::move(tmp[0]));
+	auto cb = mComputeCommandBuffers.back().get();
+	cb.begin(vk::CommandBufferBeginInfo{ vk::CommandBufferUsageFlagBits::eOneTimeSubmit });
+	mComputeCommandBufferRecording = true;
+	mBoundDescriptorSets[1] = nullptr;
+	mBoundPipelineLayouts[1] = nullptr;
+	mBoundComputePipeline = nullptr;
+	return cb;
+}
+
 void vklBindDescriptorSetToPipeline(VkDescriptorSet descriptor_set, VkPipeline pipeline)
+{
+	vklBindDescriptorSetToPipeline(descriptor_set, pipeline, {});
+}
+
+void vklBindDescriptorSetToPipeline(VkDescriptorSet descriptor_set, VkPipeline pipeline, const std::vector<uint32_t>& dynamic_offsets)
 {
 	if (!vklFrameworkInitialized()) {
 		VKL_EXIT_WITH_ERROR("Framework not initialized. Ensure to invoke vklInitFramework beforehand!");
 	}
-	if (mSingleUseCommandBuffers.empty()) {
+	// Compute pipelines are bound to the compute bind point of the compute command buffer, all others to the graphics bind point:
+	const auto* slot = findPipelineSlot(pipeline);
+	const auto bindPoint = nullptr != slot ? slot->mBindPoint : vk::PipelineBindPoint::eGraphics;
+	if (vk::PipelineBindPoint::eGraphics == bindPoint && mSingleUseCommandBuffers.empty()) {
 		VKL_EXIT_WITH_ERROR("There are no command buffers to record commands into. Have you called vklStartRecordingCommands() beforehand?");
 	}
-	auto& cb = mSingleUseCommandBuffers.back().get();
-
-	pipeline = getGraphicsPipelineOrItsSurrogate(pipeline);
+	auto cb = vk::PipelineBindPoint::eCompute == bindPoint ? getCurrentComputeCommandBuffer() : mSingleUseCommandBuffers.back().get();
 
-	auto searchPl = mPipelineLayouts.find(pipeline);
-	if (mPipelineLayouts.end() == searchPl) {
-		VKL_EXIT_WITH_ERROR("Couldn't find the VkPipeline passed to vklBindDescriptorSetToPipeline. Is it a valid handle and has it been created with vklCreateGraphicsPipeline(...)?");
-	}
-	
 	auto dset = vk::DescriptorSet{ descriptor_set };
-	auto pipe = vk::Pipeline{ pipeline };
-	auto pipeLayout = std::get<vk::UniquePipelineLayout>(searchPl->second).get();
+	auto pipeLayout = vk::PipelineLayout{ vklGetLayoutForPipeline(pipeline) };
+
+	// Pipelines with the same (interned) layout are compatible, i.e., binding a pipeline does not disturb a descriptor set
+	// bound with the same layout before. Hence, there is no need to bind the same descriptor set again:
+	const auto tracked = vk::PipelineBindPoint::eCompute == bindPoint ? 1 : 0;
+	// (Descriptor sets with dynamic uniform buffers have to be bound again if any of their dynamic offsets changes, though.)
+	if (mBoundDescriptorSets[tracked] == dset && mBoundPipelineLayouts[tracked] == pipeLayout && mBoundDynamicOffsets[tracked] == dynamic_offsets) {
+		return;
+	}
+	mBoundDescriptorSets[tracked] = dset;
+	mBoundPipelineLayouts[tracked] = pipeLayout;
+	mBoundDynamicOffsets[tracked] = dynamic_offsets;
 
 	cb.bindDescriptorSets(
-		vk::PipelineBindPoint::eGraphics, pipeLayout,
+		bindPoint, pipeLayout,
 		0u, 1u, &dset, // <--- Bind the actual descriptors to the pipeline
-		0u, nullptr
+		static_cast<uint32_t>(dynamic_offsets.size()), dynamic_offsets.data() // <--- One offset per dynamic descriptor, in binding order
 	);
 }
 
 VkPipelineLayout vklGetLayoutForPipeline(VkPipeline pipeline)
 {
-	pipeline = getGraphicsPipelineOrItsSurrogate(pipeline);
-
+	// Slot handles resolve directly, other handles (e.g., vklGetBasicPipeline's) are looked up:
+	const auto* slot = findPipelineSlot(pipeline);
+	if (nullptr != slot) {
+		return static_cast<VkPipelineLayout>(slot->mLayouts->mPipelineLayout.get());
+	}
 	auto searchPl = mPipelineLayouts.find(pipeline);
 	if (mPipelineLayouts.end() == searchPl) {
 		VKL_EXIT_WITH_ERROR("Couldn't find the VkPipeline passed to vklBindDescriptorSetToPipeline. Is it a valid handle and has it been created with vklCreateGraphicsPipeline(...)?");
 	}
-	return static_cast<VkPipelineLayout>(std::get<vk::UniquePipelineLayout>(searchPl->second).get());
+	return static_cast<VkPipelineLayout>(searchPl->second->mPipelineLayout.get());
 }
 
 bool vklInitFramework(VkInstance vk_instance, VkSurfaceKHR vk_surface, VkPhysicalDevice vk_physical_device, VkDevice vk_device, VkQueue vk_queue, const VklSwapchainConfig& swapchain_config)
@@ -1103,10 +4525,26 @@ bool vklInitFramework(VkInstance vk_instance, VkSurfaceKHR vk_surface, VkPhysica
 	mSurface = vk::SurfaceKHR{ vk_surface };
 	mPhysicalDevice = vk::PhysicalDevice{ vk_physical_device };
 	mDevice = vk::Device{ vk_device };
+	mMemoryProperties = mPhysicalDevice.getMemoryProperties();
+	mMemoryTypeLookup.clear();
 	mDispatchLoader = vk::DispatchLoaderStatic();
 	mQueue = vk::Queue{ vk_queue };
 	mSwapchainConfig = swapchain_config;
 
+	// Measure how long the individual phases of the initialization take:
+	const auto initFrameworkStartTime = std::chrono::steady_clock::now();
+	auto phaseStartTime = initFrameworkStartTime;
+	auto endPhase = [&phaseStartTime](double& out_milliseconds) {
+		out_milliseconds = millisecondsSince(phaseStartTime);
+		phaseStartTime = std::chrono::steady_clock::now();
+	};
+	{
+		std::lock_guard<std::mutex> lock(mStartupTimingsMutex);
+		mStartupTimings = VklStartupTimings{};
+	}
+	mFirstFramePresented = false;
+	mInitFrameworkStartTime = initFrameworkStartTime;
+
 	// Create a DYNAMIC DISPATCH LOADER:
 	mDynamicDispatch = vk::DispatchLoaderDynamic{ static_cast<VkInstance>(mInstance), vkGetInstanceProcAddr };
 	
@@ -1117,6 +4555,7 @@ bool vklInitFramework(VkInstance vk_instance, VkSurfaceKHR vk_surface, VkPhysica
 		vk::DebugUtilsMessageTypeFlagBitsEXT::eValidation,
 		DebugUtilsMessengerCallback, nullptr
 	}, nullptr, mDynamicDispatch);
+	endPhase(mStartupTimings.debugMessengerMilliseconds);
 
 	// See if we can get some information about the surface:
 	auto surfaceCapabilities = mPhysicalDevice.getSurfaceCapabilitiesKHR(mSurface);
@@ -1232,6 +4671,7 @@ bool vklInitFramework(VkInstance vk_instance, VkSurfaceKHR vk_surface, VkPhysica
 	}
 
 	mHasDepthAttachments = !depthAttachmentsInSubpass0.empty();
+	endPhase(mStartupTimings.imageViewsMilliseconds);
 
 	// Create the RENDERPASS:
 	// ad 2) Describe per subpass for each attachment how it is going to be used, and into which layout it shall be transferred
@@ -1288,6 +4728,7 @@ bool vklInitFramework(VkInstance vk_instance, VkSurfaceKHR vk_surface, VkPhysica
 		.setDependencyCount(static_cast<uint32_t>(subpassDependencies.size()))
 		.setPDependencies(subpassDependencies.data());
 	mRenderpass = mDevice.createRenderPassUnique(renderpassCreateInfo, nullptr, mDispatchLoader);
+	endPhase(mStartupTimings.renderPassMilliseconds);
 
 	// Create the FRAMEBUFFERS
 	mFramebuffers.reserve(mSwapchainImageViews.size());
@@ -1302,6 +4743,7 @@ bool vklInitFramework(VkInstance vk_instance, VkSurfaceKHR vk_surface, VkPhysica
 
 		mFramebuffers.push_back(mDevice.createFramebufferUnique(framebufferCreateInfo, nullptr, mDispatchLoader));
 	}
+	endPhase(mStartupTimings.framebuffersMilliseconds);
 
 	// Create SEMAPHORES and FENCES, and also prepare the safety-vector of FENCES
 	for (size_t i = 0; i < CONCURRENT_FRAMES; ++i) {
@@ -1310,15 +4752,45 @@ bool vklInitFramework(VkInstance vk_instance, VkSurfaceKHR vk_surface, VkPhysica
 		mSyncHostWithDeviceFence[i] = mDevice.createFenceUnique(vk::FenceCreateInfo{}.setFlags(vk::FenceCreateFlagBits::eSignaled), nullptr, mDispatchLoader);
 	}
 	mImagesInFlightFenceIndices.resize(mFramebuffers.size(), -1);
+	endPhase(mStartupTimings.syncObjectsMilliseconds);
 
 	mFrameId = -1;
 	// We have to make sure that not more than #CONCURRENT_FRAMES are in flight at the same time. We can use fences to ensure that. 
 	mFrameInFlightIndex = -1; // Initialize
+
+	// Note: The basic pipeline is created lazily in vklGetBasicPipeline, and glslang is initialized lazily when the first GLSL shader is compiled.
+
+	// Create the PIPELINE CACHE which is used for all pipelines, and which is stored to disk in vklDestroyFramework:
+	mPipelineCacheStatistics = VklPipelineCacheStatistics{};
+	createPipelineCache();
+	endPhase(mStartupTimings.pipelineCacheMilliseconds);
+
+	mGraphicsPipelineLibraryInUse = mGraphicsPipelineLibraryRequested && isGraphicsPipelineLibrarySupported();
+	if (mGraphicsPipelineLibraryRequested && !mGraphicsPipelineLibraryInUse) {
+		VKL_WARNING("VK_EXT_graphics_pipeline_library is not supported by the physical device. Graphics pipelines are created without pipeline libraries.");
+	}
+
+	mShaderModuleIdentifiersInUse = mShaderModuleCacheConfig.useShaderModuleIdentifiers && isShaderModuleIdentifierSupported();
+	if (mShaderModuleCacheConfig.useShaderModuleIdentifiers && !mShaderModuleIdentifiersInUse) {
+		VKL_WARNING("VK_EXT_shader_module_identifier is not supported by the physical device. Graphics pipelines are created from shader modules only.");
+	}
+	if (mShaderModuleIdentifiersInUse) {
+		mDynamicDispatch.init(mDevice); // Load vkGetShaderModuleIdentifierEXT
+	}
+
+	// Create a default COMMAND POOL which command buffers will be allocated from during vklStartRecordingCommands()
+	mCommandPool = mDevice.createCommandPoolUnique(vk::CommandPoolCreateInfo{ vk::CommandPoolCreateFlagBits::eTransient }, nullptr, mDispatchLoader);
+	endPhase(mStartupTimings.commandPoolMilliseconds);
+	mStartupTimings.initFrameworkMilliseconds = millisecondsSince(initFrameworkStartTime);
 	
-#ifdef USE_GLSLANG
-	glslang_initialize_process();
-#endif
-	mBasicPipeline = vk::Pipeline{ createGraphicsPipelineInternal(VklGraphicsPipelineConfig{
+	mFrameworkInitialized = true;
+	return mFrameworkInitialized;
+}
+
+// Creates the pipeline returned by vklGetBasicPipeline, preferably from SPIR-V which has been compiled at build time.
+vk::Pipeline createBasicPipeline()
+{
+	auto basicPipelineConfig = VklGraphicsPipelineConfig{
 		// Vertex Shader from memory:
 			"#version 450\n"
 			"layout(location = 0) in vec3 position;\n"
@@ -1341,13 +4813,20 @@ bool vklInitFramework(VkInstance vk_instance, VkSurfaceKHR vk_surface, VkPhysica
 		VK_POLYGON_MODE_FILL,
 		VK_CULL_MODE_NONE,
 		{ /* no descriptors */ }
-	}, /* load shaders from memory: */ true) };
-
-	// Create a default COMMAND POOL which command buffers will be allocated from during vklStartRecordingCommands()
-	mCommandPool = mDevice.createCommandPoolUnique(vk::CommandPoolCreateInfo{ vk::CommandPoolCreateFlagBits::eTransient }, nullptr, mDispatchLoader);
-	
-	mFrameworkInitialized = true;
-	return mFrameworkInitialized;
+	};
+#ifdef VKL_HAS_PRECOMPILED_BASIC_SHADERS
+	// The same shaders, compiled at build time from shaders/vkl_basic.vert and shaders/vkl_basic.frag:
+	basicPipelineConfig.vertexShaderSpirv = vkl_basic_vert_spv;
+	basicPipelineConfig.vertexShaderSpirvSizeInBytes = sizeof(vkl_basic_vert_spv);
+	basicPipelineConfig.fragmentShaderSpirv = vkl_basic_frag_spv;
+	basicPipelineConfig.fragmentShaderSpirvSizeInBytes = sizeof(vkl_basic_frag_spv);
+#endif
+	const auto t0 = std::chrono::steady_clock::now();
+	auto basicPipeline = vk::Pipeline{ createGraphicsPipelineInternal(basicPipelineConfig, /* load shaders from memory: */ true) };
+	if (!mFirstFramePresented) {
+		mStartupTimings.pipelinesMilliseconds += millisecondsSince(t0);
+	}
+	return basicPipeline;
 }
 
 #ifdef VKL_HAS_VMA
@@ -1373,18 +4852,53 @@ bool vklFrameworkInitialized()
 void vklDestroyFramework()
 {
 	mDevice.waitIdle();
+	destroyStagingRing();
+	destroyAsyncUploads();
+	destroyUniformAllocator();
 	mFrameworkInitialized = false;
 
+	// Let pending hot-reloads and pipeline creations finish (reloaded pipelines are destroyed right away), and shut down the worker threads:
+	applyFinishedPipelineCreations(/* waitForAll: */ true);
+	applyFinishedPipelineReloads(/* waitForAll: */ true);
+	applyFinishedPipelineOptimizations(/* waitForAll: */ true);
+	destroyUnusedPrewarmedPipelines();
+	mWorkerPool.stop();
+	mShaderFileWatchingEnabled = false;
+	closeShaderFileWatcher();
+	mPipelineSpirvHashes.clear();
+	mPendingPipelineCreations.clear();
+	// Slot generations start over after re-initialization, hence forget the slot handles of pipelines which have not been destroyed:
+	mPipelineSlots.clear();
+	mFreePipelineSlots.clear();
+	mUserKnownPipelines.clear();
+	mUserKnownComputePipelines.clear();
+	mPipelinesByConfigKey.clear();
+	mPipelineReferences.clear();
+
 	// DESTROOOOOOOOY:
 
 	mSingleUseCommandBuffers.clear();
+	mComputeCommandBuffers.clear();
+	mComputeCommandBufferRecording = false;
+	destroyMemoryAllocator();
 
 	mPipelineLayouts.clear();
+	mInternedPipelineLayouts.clear();
 
 	mCommandPool.reset();
-	mDevice.destroyPipeline(mBasicPipeline);
+	if (mBasicPipeline) {
+		mDevice.destroyPipeline(mBasicPipeline);
+		mBasicPipeline = nullptr;
+	}
+	mFastLinkedPipelines.clear(); // => Destroys all libraries
+	mOptimizedPipelineLibraries.clear();
+	mPipelineLibraries.clear();
+	vklPurgeShaderModuleCache();
+	mShaderModuleIdentifiersInUse = false;
+	saveAndDestroyPipelineCache();
+	savePipelineManifest();
 #ifdef USE_GLSLANG
-	glslang_finalize_process();
+	finalizeGlslangIfInitialized();
 #endif
 	mImagesInFlightFenceIndices.clear();
 	for (size_t i = 0; i < CONCURRENT_FRAMES; ++i) {
@@ -1405,11 +4919,168 @@ void vklDestroyFramework()
 	mDebugUtilsMessenger = nullptr;
 }
 
+// Swaps in hot-reloaded pipelines into the slots of their handles, as soon as they are ready.
+// This is invoked at frame boundaries, i.e., never while commands are being recorded.
+void applyFinishedPipelineReloads(bool waitForAll)
+{
+	if (mPendingPipelineReloads.empty()) {
+		return;
+	}
+
+	// Apply in submission order, so that the latest reload of a pipeline always wins:
+	while (!mPendingPipelineReloads.empty()) {
+		auto& pending = mPendingPipelineReloads.front();
+		if (!waitForAll && std::future_status::ready != pending.mPipelineObjects.wait_for(std::chrono::seconds(0))) {
+			return;
+		}
+		const auto originalHandle = pending.mOriginalHandle;
+		VklPipelineObjects objects;
+		try {
+			objects = pending.mPipelineObjects.get();
+		}
+		catch (const std::exception& e) {
+			VKL_WARNING("Hot-reloading a graphics pipeline failed: " << e.what());
+		}
+		mPendingPipelineReloads.pop_front();
+
+		if (objects.mSpirvUnchanged) {
+			// Keep the current pipeline, but remember the modified files, so that it is not reloaded again until they change once more:
+			auto* shaderFiles = findKnownPipelineShaderFiles(originalHandle);
+			if (nullptr != shaderFiles) {
+				*shaderFiles = std::move(objects.mShaderFiles);
+				mShaderFileWatchesOutdated = true;
+			}
+			++mNumUnchangedPipelinesInReload;
+			continue;
+		}
+		if (!objects.mPipeline) {
+			continue; // => Keep using the previous pipeline. Check console output for shader compilation errors!
+		}
+		auto* slot = findPipelineSlot(originalHandle);
+		if (nullptr == slot || !vklFrameworkInitialized()) {
+			// The pipeline has been destroyed in the meantime:
+			destroyUnregisteredPipeline(objects.mPipeline);
+			continue;
+		}
+
+		// Remember the files the new pipeline has been built from, so that it is only reloaded again if one of them changes:
+		*findKnownPipelineShaderFiles(originalHandle) = std::move(objects.mShaderFiles);
+		mShaderFileWatchesOutdated = true;
+
+		auto pendingCreation = mPendingPipelineCreations.find(originalHandle);
+		if (mPendingPipelineCreations.end() != pendingCreation) {
+			// The asynchronous creation of this pipeline has failed, and the reload is its first working version => nothing to destroy:
+			mPendingPipelineCreations.erase(pendingCreation);
+		}
+		else {
+			// The outdated pipeline may still be in use by frames in flight:
+			mPipelineGraveyard.push_back(std::make_tuple(mFrameId + CONCURRENT_FRAMES, slot->mPipeline));
+		}
+
+		// And the handle resolves to the new pipeline from now on:
+		slot->mPipeline = registerPipeline(std::move(objects));
+		scheduleLinkTimeOptimization(originalHandle);
+	}
+
+	const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - mPipelineReloadStartTime).count();
+	VKL_LOG("Hot-reloaded " << mNumPipelinesInReload << " pipelines in " << elapsed << " ms using " << mWorkerPool.mThreads.size() << " worker threads"
+		<< " (" << mNumUnchangedPipelinesInReload << " of them kept, because their SPIR-V has not changed).");
+}
+
 // Delete those pipelines which are no longer used due having been replaced after hot reloading
 void destroyOutdatedPipelines() 
 {
-	while (!mPipelineGraveyard.empty() && std::get<0>(*mPipelineGraveyard.begin()) < mFrameId) {
-		destroyGraphicsPipelineInternal(std::get<1>(*mPipelineGraveyard.begin()));
+	while (!mPipelineGraveyard.empty() && std::get<0>(mPipelineGraveyard.front()) < mFrameId) {
+		destroyPipelineInternal(std::get<1>(mPipelineGraveyard.front()));
+		mPipelineGraveyard.pop_front();
+	}
+}
+
+// Swaps in asynchronously created pipelines into their slots, as soon as they are ready,
+// and destroys pipelines whose creation has been abandoned. This is invoked at frame boundaries.
+void applyFinishedPipelineCreations(bool waitForAll)
+{
+	const auto isReady = [waitForAll](const std::future<VklPipelineObjects>& future) {
+		return future.valid() && (waitForAll || std::future_status::ready == future.wait_for(std::chrono::seconds(0)));
+	};
+	const auto getObjects = [](std::future<VklPipelineObjects>& future) {
+		try {
+			return future.get();
+		}
+		catch (const std::exception& e) {
+			VKL_WARNING("Creating a graphics pipeline asynchronously failed: " << e.what());
+		}
+		return VklPipelineObjects{};
+	};
+
+	for (auto it = mPendingPipelineCreations.begin(); it != mPendingPipelineCreations.end();) {
+		if (!isReady(it->second)) {
+			++it;
+			continue;
+		}
+		const auto pipelineHandle = it->first;
+		auto objects = getObjects(it->second);
+		// Remember the files the pipeline has been built from, so that it can be hot-reloaded:
+		std::get<4>(mUserKnownPipelines[pipelineHandle]) = std::move(objects.mShaderFiles);
+		mShaderFileWatchesOutdated = true;
+		if (!objects.mPipeline) {
+			// Keep using the fallback. Check console output for shader compilation errors, and hot-reload once they are fixed!
+			VKL_WARNING("Creating a graphics pipeline asynchronously failed, its fallback pipeline will be used instead.");
+			++it;
+			continue;
+		}
+		findPipelineSlot(pipelineHandle)->mPipeline = registerPipeline(std::move(objects));
+		scheduleLinkTimeOptimization(pipelineHandle);
+		it = mPendingPipelineCreations.erase(it);
+	}
+
+	for (auto it = mAbandonedPipelineCreations.begin(); it != mAbandonedPipelineCreations.end();) {
+		if (!isReady(*it)) {
+			++it;
+			continue;
+		}
+		auto objects = getObjects(*it);
+		if (objects.mPipeline) {
+			destroyUnregisteredPipeline(objects.mPipeline);
+		}
+		it = mAbandonedPipelineCreations.erase(it);
+	}
+}
+
+// Swaps in pipelines which have been linked with link-time optimization, replacing their fast-linked versions.
+// This is invoked at frame boundaries.
+void applyFinishedPipelineOptimizations(bool waitForAll)
+{
+	for (auto it = mPendingPipelineOptimizations.begin(); it != mPendingPipelineOptimizations.end();) {
+		if (!waitForAll && std::future_status::ready != it->mPipelineObjects.wait_for(std::chrono::seconds(0))) {
+			++it;
+			continue;
+		}
+		const auto originalHandle = it->mOriginalHandle;
+		const auto fastLinkedHandle = it->mFastLinkedHandle;
+		auto libraries = std::move(it->mLibraries);
+		VklPipelineObjects objects;
+		try {
+			objects = it->mPipelineObjects.get();
+		}
+		catch (const std::exception& e) {
+			VKL_WARNING("Linking a graphics pipeline with link-time optimization failed: " << e.what());
+		}
+		it = mPendingPipelineOptimizations.erase(it);
+
+		if (!objects.mPipeline) {
+			continue; // => Keep using the fast-linked pipeline
+		}
+		auto* slot = findPipelineSlot(originalHandle);
+		if (!vklFrameworkInitialized() || nullptr == slot || slot->mPipeline != fastLinkedHandle) {
+			// The pipeline has been destroyed or hot-reloaded in the meantime:
+			mDevice.destroyPipeline(objects.mPipeline);
+			continue;
+		}
+		mPipelineGraveyard.push_back(std::make_tuple(mFrameId + CONCURRENT_FRAMES, fastLinkedHandle));
+		slot->mPipeline = registerPipeline(std::move(objects));
+		std::lock_guard<std::mutex> lock(mPipelineLibrariesMutex);
+		mOptimizedPipelineLibraries[slot->mPipeline] = std::move(libraries);
 	}
 }
 
@@ -1419,7 +5090,11 @@ double vklWaitForNextSwapchainImage()
 		VKL_EXIT_WITH_ERROR("Framework not initialized. Ensure to invoke vklInitFramework beforehand!");
 	}
 
+	pollShaderFileWatcher();
 	destroyOutdatedPipelines();
+	applyFinishedPipelineCreations(/* waitForAll: */ false);
+	applyFinishedPipelineReloads(/* waitForAll: */ false);
+	applyFinishedPipelineOptimizations(/* waitForAll: */ false);
 
 	// Advance the frame ID:
 	++mFrameId;
@@ -1435,6 +5110,11 @@ double vklWaitForNextSwapchainImage()
 	returnCode = mDevice.resetFences(1u, &mSyncHostWithDeviceFence[mFrameInFlightIndex].get());
 	VKL_CHECK_VULKAN_ERROR(static_cast<VkResult>(returnCode));
 
+	// The frame which has last signaled this fence is done, and so are its uploads and its uniform data:
+	releaseStagingRingSpace(mFrameId - CONCURRENT_FRAMES);
+	collectFinishedAsyncUploads();
+	mUniformBufferHeads[mFrameInFlightIndex] = 0;
+
 	// Keep house with the in-flight images:
 	for (auto& mapping : mImagesInFlightFenceIndices) { // However, we don't know which index this fence had been mapped to => we have to search
 		if (mFrameInFlightIndex == mapping) {
@@ -1498,6 +5178,33 @@ void vklPresentCurrentSwapchainImage()
 	VKL_CHECK_VULKAN_ERROR(static_cast<VkResult>(returnCode));
 
 	mImagesInFlightFenceIndices[mCurrentSwapChainImageIndex] = mFrameInFlightIndex;
+
+	if (!mFirstFramePresented) {
+		mFirstFramePresented = true;
+		std::lock_guard<std::mutex> lock(mStartupTimingsMutex);
+		mStartupTimings.timeToFirstFrameMilliseconds = millisecondsSince(mInitFrameworkStartTime);
+		const auto& t = mStartupTimings;
+		VKL_LOG("Time to first frame: " << t.timeToFirstFrameMilliseconds << " ms. vklInitFramework: " << t.initFrameworkMilliseconds << " ms ("
+			<< "debug messenger: " << t.debugMessengerMilliseconds << " ms, image views: " << t.imageViewsMilliseconds << " ms, render pass: " << t.renderPassMilliseconds
+			<< " ms, framebuffers: " << t.framebuffersMilliseconds << " ms, sync objects: " << t.syncObjectsMilliseconds << " ms, pipeline cache: " << t.pipelineCacheMilliseconds << " ms, command pool: " << t.commandPoolMilliseconds
+			<< " ms), pipelines: " << t.pipelinesMilliseconds << " ms, shader compiler initialization: " << t.shaderCompilerInitializationMilliseconds << " ms.");
+	}
+}
+
+VklStartupTimings vklGetStartupTimings()
+{
+	std::lock_guard<std::mutex> lock(mStartupTimingsMutex);
+	return mStartupTimings;
+}
+
+// Sets the viewport and scissor to the whole framebuffer, for all pipelines with dynamic viewport and scissor state.
+void setFramebufferViewportAndScissor(vk::CommandBuffer cb)
+{
+	cb.setViewport(0u, vk::Viewport{}
+		.setX(0.0f).setY(0.0f)
+		.setWidth(static_cast<float>(mSwapchainConfig.imageExtent.width)).setHeight(static_cast<float>(mSwapchainConfig.imageExtent.height))
+		.setMinDepth(0.0f).setMaxDepth(1.0f));
+	cb.setScissor(0u, vk::Rect2D{}.setOffset({ 0, 0 }).setExtent(mSwapchainConfig.imageExtent));
 }
 
 void vklStartRecordingCommands()
@@ -1527,12 +5234,19 @@ void vklStartRecordingCommands()
 	
 	// Start recording:
 	cb.begin(vk::CommandBufferBeginInfo{ vk::CommandBufferUsageFlagBits::eOneTimeSubmit });
+	mBoundDescriptorSets[0] = nullptr;
+	mBoundPipelineLayouts[0] = nullptr;
 
 	cb.beginRenderPass(vk::RenderPassBeginInfo{
 		mRenderpass.get(), mFramebuffers[mCurrentSwapChainImageIndex].get(),
 		vk::Rect2D{vk::Offset2D{0, 0}, mSwapchainConfig.imageExtent},
 		static_cast<uint32_t>(mClearValues[mCurrentSwapChainImageIndex].size()), mClearValues[mCurrentSwapChainImageIndex].data()
 		}, vk::SubpassContents::eInline);
+
+	// Binding a pipeline with static viewport and scissor state invalidates these, hence vklCmdBindPipeline sets them again
+	// when a pipeline with dynamic viewport and scissor state is bound afterwards:
+	setFramebufferViewportAndScissor(cb);
+	mStaticViewportAndScissorBound = false;
 }
 
 void vklEndRecordingCommands()
@@ -1550,10 +5264,77 @@ void vklEndRecordingCommands()
 	// Stop recording:
 	cb.end();
 
-	mQueue.submit({ vk::SubmitInfo{}
-						.setCommandBufferCount(1u)
-						.setPCommandBuffers(&cb)
-					});
+	std::vector<vk::CommandBuffer> commandBuffers;
+
+	// Acquire the resources of all asynchronous uploads which have completed, or which this frame waits for:
+	std::vector<vk::BufferMemoryBarrier> bufferAcquireBarriers;
+	std::vector<vk::ImageMemoryBarrier> imageAcquireBarriers;
+	uint64_t uploadTimelineValueToWaitFor = 0;
+	if (mAcquiredUploadTimelineValue < mLastUploadTimelineValue) {
+		uploadTimelineValueToWaitFor = std::max(getCompletedUploadTimelineValue(), mUploadTimelineValueToWaitFor);
+		for (const auto& upload : mAsyncUploads) {
+			if (upload.mTimelineValue > mAcquiredUploadTimelineValue && upload.mTimelineValue <= uploadTimelineValueToWaitFor) {
+				bufferAcquireBarriers.insert(bufferAcquireBarriers.end(), upload.mBufferAcquireBarriers.begin(), upload.mBufferAcquireBarriers.end());
+				imageAcquireBarriers.insert(imageAcquireBarriers.end(), upload.mImageAcquireBarriers.begin(), upload.mImageAcquireBarriers.end());
+			}
+		}
+		if (uploadTimelineValueToWaitFor <= mAcquiredUploadTimelineValue) {
+			uploadTimelineValueToWaitFor = 0; // Nothing new to acquire
+		}
+		else {
+			mAcquiredUploadTimelineValue = uploadTimelineValueToWaitFor;
+		}
+	}
+	mUploadTimelineValueToWaitFor = 0;
+
+	// Uploads into device-local buffers are executed before the frame's compute and rendering work:
+	auto uploadCb = recordUploadCommands(bufferAcquireBarriers, imageAcquireBarriers);
+	if (uploadCb) {
+		const auto numToKeep = static_cast<size_t>(std::max(static_cast<int>(mSwapchainImageViews.size()), int{ CONCURRENT_FRAMES }));
+		while (mUploadCommandBuffers.size() > numToKeep) {
+			mUploadCommandBuffers.pop_front();
+		}
+		commandBuffers.push_back(uploadCb.get());
+		mUploadCommandBuffers.push_back(std::move(uploadCb));
+	}
+	// Remember which part of the staging ring this frame's uploads occupy, until its fence has been waited for:
+	if (mStagingRingFrames.empty() ? mStagingRingHead != mStagingRingTail : std::get<vk::DeviceSize>(mStagingRingFrames.back()) != mStagingRingHead) {
+		mStagingRingFrames.emplace_back(mFrameId, mStagingRingHead);
+	}
+
+	// The compute work of this frame (if any) is executed before the frame's rendering commands:
+	if (mComputeCommandBufferRecording) {
+		auto computeCb = mComputeCommandBuffers.back().get();
+		// Make everything written by compute shaders visible to the rendering commands, e.g., culled draw calls or skinned vertices:
+		computeCb.pipelineBarrier(
+			vk::PipelineStageFlagBits::eComputeShader,
+			vk::PipelineStageFlagBits::eDrawIndirect | vk::PipelineStageFlagBits::eVertexInput | vk::PipelineStageFlagBits::eVertexShader | vk::PipelineStageFlagBits::eFragmentShader,
+			vk::DependencyFlags{},
+			vk::MemoryBarrier{ vk::AccessFlagBits::eShaderWrite, vk::AccessFlagBits::eIndirectCommandRead | vk::AccessFlagBits::eIndexRead | vk::AccessFlagBits::eVertexAttributeRead | vk::AccessFlagBits::eUniformRead | vk::AccessFlagBits::eShaderRead },
+			nullptr, nullptr);
+		computeCb.end();
+		mComputeCommandBufferRecording = false;
+		commandBuffers.push_back(computeCb);
+	}
+	commandBuffers.push_back(cb);
+
+	auto submitInfo = vk::SubmitInfo{}
+		.setCommandBufferCount(static_cast<uint32_t>(commandBuffers.size()))
+		.setPCommandBuffers(commandBuffers.data());
+	// Make the frame wait for the asynchronous uploads it acquires, which also makes their data visible to it:
+	const auto uploadTimelineSemaphore = mUploadTimelineSemaphore.get();
+	const vk::PipelineStageFlags uploadWaitStage = vk::PipelineStageFlagBits::eAllCommands;
+	auto timelineSubmitInfo = vk::TimelineSemaphoreSubmitInfo{}
+		.setWaitSemaphoreValueCount(1u)
+		.setPWaitSemaphoreValues(&uploadTimelineValueToWaitFor);
+	if (0 != uploadTimelineValueToWaitFor) {
+		submitInfo
+			.setPNext(&timelineSubmitInfo)
+			.setWaitSemaphoreCount(1u)
+			.setPWaitSemaphores(&uploadTimelineSemaphore)
+			.setPWaitDstStageMask(&uploadWaitStage);
+	}
+	mQueue.submit({ submitInfo });
 }
 
 uint32_t vklGetCurrentSwapChainImageIndex()
@@ -1592,8 +5373,22 @@ VkCommandBuffer vklGetCurrentCommandBuffer()
 	return static_cast<VkCommandBuffer>(cb);
 }
 
+VkCommandBuffer vklGetCurrentComputeCommandBuffer()
+{
+	if (!vklFrameworkInitialized()) {
+		VKL_EXIT_WITH_ERROR("Framework not initialized. Ensure to invoke vklInitFramework beforehand!");
+	}
+	return static_cast<VkCommandBuffer>(getCurrentComputeCommandBuffer());
+}
+
 VkPipeline vklGetBasicPipeline()
 {
+	if (!vklFrameworkInitialized()) {
+		VKL_EXIT_WITH_ERROR("Framework not initialized. Ensure to invoke vklInitFramework beforehand!");
+	}
+	if (!mBasicPipeline) {
+		mBasicPipeline = createBasicPipeline();
+	}
     return static_cast<VkPipeline>(mBasicPipeline);
 }
 
@@ -1632,54 +5427,13 @@ VkImage vklCreateDeviceLocalImageWithBackingMemory(VkPhysicalDevice physical_dev
 
 	auto image = vk::Device{ device }.createImage(createInfo);
 
-	auto memoryRequirements = vk::Device{ device }.getImageMemoryRequirements(image);
+	// In contrast to our host-coherent buffers, we just assume that we want all our images to live in device memory:
+	auto memory = allocateResourceMemory(vk::Device{ device }.getImageMemoryRequirements(image), vk::MemoryPropertyFlagBits::eDeviceLocal, vk::MemoryPropertyFlags{}, /* optimal_image: */ true);
 
-	auto memoryAllocInfo = vk::MemoryAllocateInfo{}
-		.setAllocationSize(memoryRequirements.size)
-		.setMemoryTypeIndex([&]() {
-			// Get memory types supported by the physical device:
-			auto memoryProperties = vk::PhysicalDevice{ physical_device }.getMemoryProperties();
-
-			// In search for a suitable memory type INDEX:
-			int selectedMemIndex = -1;
-			vk::DeviceSize selectedHeapSize = 0;
-			for (int i = 0; i < static_cast<int>(memoryProperties.memoryTypeCount); ++i) {
-
-				// Is this kind of memory suitable for our image?
-				const auto bitmask = memoryRequirements.memoryTypeBits;
-				const auto bit = 1 << i;
-				if (0 == (bitmask & bit)) {
-					continue; // => nope
-				}
-
-				// Does this kind of memory support our usage requirements?
-
-				// In contrast to our host-coherent buffers, we just assume that we want all our images to live in device memory:
-				if ((memoryProperties.memoryTypes[i].propertyFlags & vk::MemoryPropertyFlagBits::eDeviceLocal) != vk::MemoryPropertyFlags{}) {
-					// Would support => now select the one with the largest heap:
-					const auto heapSize = memoryProperties.memoryHeaps[memoryProperties.memoryTypes[i].heapIndex].size;
-					if (heapSize > selectedHeapSize) {
-						// We have a new king:
-						selectedMemIndex = i;
-						selectedHeapSize = heapSize;
-					}
-				}
-			}
-
-			if (-1 == selectedMemIndex) {
-				VKL_EXIT_WITH_ERROR(std::string("ERROR: Couldn't find suitable memory for image, requirements[") + std::to_string(memoryRequirements.alignment) + ", " + std::to_string(memoryRequirements.memoryTypeBits) + ", " + std::to_string(memoryRequirements.size) + "]");
-			}
-
-			// all good, we found a suitable memory index:
-			return static_cast<uint32_t>(selectedMemIndex);
-		}());
-
-	auto memory = vk::Device{ device }.allocateMemoryUnique(memoryAllocInfo, nullptr, mDispatchLoader);
-
-	vk::Device{ device }.bindImageMemory(image, memory.get(), 0);
+	vk::Device{ device }.bindImageMemory(image, memory.mMemory, memory.mOffset);
 
 	// Remember the assignment:
-	mImagesWithBackingMemory[static_cast<VkImage>(image)] = std::move(memory);
+	mImagesWithBackingMemory[static_cast<VkImage>(image)] = memory;
 
 	return static_cast<VkImage>(image);
 }
@@ -1717,12 +5471,18 @@ void vklDestroyDeviceLocalImageAndItsBackingMemory(VkImage image)
 	bool resourceDestroyed = false;
 	auto search = mImagesWithBackingMemory.find(image);
 	if (mImagesWithBackingMemory.end() != search) {
+		auto* allocation = getMemoryAllocation(search->second);
+		if (nullptr != allocation) {
+			// Destroy the image before its memory is returned to the allocator:
+			mDevice.destroy(vk::Image{ image });
+			freeResourceMemory(*allocation);
+		}
 #ifdef VKL_HAS_VMA
-		if (vklHasVmaAllocator() && std::holds_alternative<VmaAllocation>(search->second)) {
+		else {
 			vmaDestroyImage(mVmaAllocator, image, std::get<VmaAllocation>(search->second));
-			resourceDestroyed = true;
 		}
 #endif
+		resourceDestroyed = true;
 		mImagesWithBackingMemory.erase(search);
 	}
 	else {
@@ -2097,25 +5857,66 @@ VklGeometryData vklLoadModelGeometry(const std::string& path_to_obj)
 	return data;
 }
 
-void vklHotReloadPipelines()
+// Hot-reloads those known pipelines, of which any shader file or any file included by their shaders has changed.
+// If changedFiles is given, only the files contained in it (normalized paths) are checked, otherwise all files are.
+void hotReloadChangedPipelines(const std::unordered_set<std::string>* changedFiles)
 {
-	VKL_LOG("About to hot-reload " << mUserKnownPipelines.size() << " known graphics pipelines...");
+	std::unordered_map<std::string, VklShaderFileDependency> filesReadDuringThisCheck;
+	const auto haveChanged = [&](std::vector<VklShaderFileDependency>& shaderFiles) {
+		return std::any_of(std::begin(shaderFiles), std::end(shaderFiles), [&](VklShaderFileDependency& file) {
+			return (nullptr == changedFiles || changedFiles->count(getNormalizedShaderFilePath(file.mPath)) > 0) && hasShaderFileChanged(file, filesReadDuringThisCheck);
+		});
+	};
+	std::vector<decltype(mUserKnownPipelines)::iterator> changedPipelines;
 	for(auto it = mUserKnownPipelines.begin(); it != mUserKnownPipelines.end(); it++) {
-		auto originalHandle = it->first;
-		std::get<0>(it->second).vertexShaderPath   = std::get<1>(it->second).c_str();
-		std::get<0>(it->second).fragmentShaderPath = std::get<2>(it->second).c_str();
-		auto newHandle = createGraphicsPipelineInternal(std::get<0>(it->second), std::get<3>(it->second));
-		if (VK_NULL_HANDLE == newHandle) {
-			continue;
+		if (haveChanged(std::get<4>(it->second))) {
+			changedPipelines.push_back(it);
 		}
+	}
+	std::vector<decltype(mUserKnownComputePipelines)::iterator> changedComputePipelines;
+	for(auto it = mUserKnownComputePipelines.begin(); it != mUserKnownComputePipelines.end(); it++) {
+		if (haveChanged(std::get<3>(it->second))) {
+			changedComputePipelines.push_back(it);
+		}
+	}
+
+	VKL_LOG("About to hot-reload " << changedPipelines.size() + changedComputePipelines.size() << " of " << mUserKnownPipelines.size() + mUserKnownComputePipelines.size() << " known pipelines, whose shader files have changed...");
+	if (changedPipelines.empty() && changedComputePipelines.empty()) {
+		return;
+	}
+	if (mPendingPipelineReloads.empty()) {
+		mPipelineReloadStartTime = std::chrono::steady_clock::now();
+		mNumPipelinesInReload = 0;
+		mNumUnchangedPipelinesInReload = 0;
+	}
 
-		// We're going to destroy one outdated pipeline in any case (regardless the mapping):
-		auto destroyHandle = getGraphicsPipelineOrItsSurrogate(originalHandle);
-		mPipelineGraveyard.push_back(std::make_tuple(mFrameId + CONCURRENT_FRAMES, destroyHandle));
+	// If the new SPIR-V turns out to be identical to that of the current pipeline, the pipeline is kept. Not if there are
+	// reloads of it in flight, though, since these would otherwise replace it after this reload has been applied:
+	const auto getCurrentSpirvHash = [](VkPipeline originalHandle) -> uint64_t {
+		if (std::any_of(std::begin(mPendingPipelineReloads), std::end(mPendingPipelineReloads), [originalHandle](const VklPendingPipelineReload& pending) { return pending.mOriginalHandle == originalHandle; })) {
+			return 0;
+		}
+		auto spirvHash = mPipelineSpirvHashes.find(resolvePipelineHandle(originalHandle));
+		return mPipelineSpirvHashes.end() != spirvHash ? spirvHash->second : 0;
+	};
 
-		// And we have a new surrogate for the original handle:
-		mPipelineSurrogates[originalHandle] = newHandle;
+	// Read the shader files on this thread, compile all stages of all pipelines on the worker threads:
+	// (Precompiled stages are never reloaded, the pipeline has been found changed due to the other stage then.)
+	for(auto it : changedPipelines) {
+		auto pipelineFuture = createGraphicsPipelineOnWorkerThreads(std::get<0>(it->second), std::get<1>(it->second).c_str(), std::get<2>(it->second).c_str(), std::get<3>(it->second), getCurrentSpirvHash(it->first));
+		mPendingPipelineReloads.push_back(VklPendingPipelineReload{ it->first, std::move(pipelineFuture) });
+		++mNumPipelinesInReload;
 	}
+	for(auto it : changedComputePipelines) {
+		auto pipelineFuture = createComputePipelineOnWorkerThreads(std::get<0>(it->second), std::get<1>(it->second).c_str(), std::get<2>(it->second), getCurrentSpirvHash(it->first));
+		mPendingPipelineReloads.push_back(VklPendingPipelineReload{ it->first, std::move(pipelineFuture) });
+		++mNumPipelinesInReload;
+	}
+}
+
+void vklHotReloadPipelines()
+{
+	hotReloadChangedPipelines(nullptr);
 }
 
 void pipelineHotReloadingCallback(GLFWwindow* glfw_window, int key, int scancode, int action, int mods) {
@@ -2138,8 +5939,190 @@ void vklEnablePipelineHotReloading(GLFWwindow* glfw_window, int glfw_key, int gl
 	}
 }
 
+// Stops watching all directories, and closes the inotify instance.
+void closeShaderFileWatcher()
+{
+#ifdef __linux__
+	if (mShaderFileWatcherFd >= 0) {
+		close(mShaderFileWatcherFd); // => also removes all watches
+		mShaderFileWatcherFd = -1;
+	}
+	mWatchedShaderDirectories.clear();
+#endif
+	mWatchedShaderFiles.clear();
+	mChangedShaderFiles.clear();
+}
+
+// Watches the directories of all files referenced by known pipelines, and stops watching directories which contain none of them anymore.
+// Directories are watched instead of files, because many editors save by writing a new file and renaming it over the old one.
+void updateShaderFileWatches()
+{
+#ifdef __linux__
+	mShaderFileWatchesOutdated = false;
+	mWatchedShaderFiles.clear();
+	std::unordered_set<std::string> directories;
+	const auto watchFiles = [&directories](const std::vector<VklShaderFileDependency>& shaderFiles) {
+		for (const auto& file : shaderFiles) {
+			auto path = getNormalizedShaderFilePath(file.mPath);
+			directories.insert(std::filesystem::path(path).parent_path().string());
+			mWatchedShaderFiles.insert(std::move(path));
+		}
+	};
+	for (const auto& pipeline : mUserKnownPipelines) {
+		watchFiles(std::get<4>(pipeline.second));
+	}
+	for (const auto& pipeline : mUserKnownComputePipelines) {
+		watchFiles(std::get<3>(pipeline.second));
+	}
+
+	for (auto it = mWatchedShaderDirectories.begin(); it != mWatchedShaderDirectories.end();) {
+		if (directories.erase(it->second) > 0) {
+			++it; // => already watched
+		}
+		else {
+			inotify_rm_watch(mShaderFileWatcherFd, it->first);
+			it = mWatchedShaderDirectories.erase(it);
+		}
+	}
+	for (const auto& directory : directories) {
+		const int wd = inotify_add_watch(mShaderFileWatcherFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+		if (wd < 0) {
+			VKL_WARNING("Unable to watch the shader directory[" << directory << "] for changes.");
+			continue;
+		}
+		mWatchedShaderDirectories[wd] = directory;
+	}
+#endif
+}
+
+// Collects the changes of watched shader files without blocking, and hot-reloads the affected pipelines
+// once no further changes have been made for the debounce duration. This is invoked at frame boundaries.
+void pollShaderFileWatcher()
+{
+	if (!mShaderFileWatchingEnabled) {
+		return;
+	}
+#ifdef __linux__
+	if (mShaderFileWatchesOutdated) {
+		updateShaderFileWatches();
+	}
+
+	alignas(inotify_event) char buffer[4096];
+	for (;;) {
+		const auto length = read(mShaderFileWatcherFd, buffer, sizeof(buffer));
+		if (length <= 0) {
+			break; // => no more events (EAGAIN)
+		}
+		for (ssize_t offset = 0; offset < length;) {
+			const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+			offset += sizeof(inotify_event) + event->len;
+			auto directory = mWatchedShaderDirectories.find(event->wd);
+			if (mWatchedShaderDirectories.end() == directory || 0 == event->len) {
+				continue;
+			}
+			auto path = (std::filesystem::path(directory->second) / event->name).string();
+			if (mWatchedShaderFiles.count(path) > 0) {
+				mChangedShaderFiles.insert(std::move(path));
+				mLastShaderFileChangeTime = std::chrono::steady_clock::now();
+			}
+		}
+	}
+
+	// Editors often write a file multiple times in a row => wait until that has settled:
+	if (mChangedShaderFiles.empty() || std::chrono::steady_clock::now() - mLastShaderFileChangeTime < mShaderFileWatchingDebounce) {
+		return;
+	}
+	const auto changedFiles = std::move(mChangedShaderFiles);
+	mChangedShaderFiles.clear();
+	hotReloadChangedPipelines(&changedFiles);
+#endif
+}
+
+bool vklEnableShaderFileWatching(bool enable, uint32_t debounce_milliseconds)
+{
+	mShaderFileWatchingDebounce = std::chrono::milliseconds(debounce_milliseconds);
+	if (!enable) {
+		mShaderFileWatchingEnabled = false;
+		closeShaderFileWatcher();
+		return true;
+	}
+#ifdef __linux__
+	if (mShaderFileWatcherFd < 0) {
+		mShaderFileWatcherFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (mShaderFileWatcherFd < 0) {
+			VKL_WARNING("Unable to create an inotify instance => shader files are not going to be watched.");
+			return false;
+		}
+	}
+	mShaderFileWatchingEnabled = true;
+	mShaderFileWatchesOutdated = true;
+	return true;
+#else
+	VKL_WARNING("Watching shader files is only supported on Linux => use vklEnablePipelineHotReloading or vklHotReloadPipelines instead.");
+	return false;
+#endif
+}
+
 void vklCmdBindPipeline(VkCommandBuffer commandBuffer, VkPipelineBindPoint pipelineBindPoint, VkPipeline pipeline)
 {
-	pipeline = getGraphicsPipelineOrItsSurrogate(pipeline);
+	const auto* slot = findPipelineSlot(pipeline);
+	if (nullptr != slot) {
+		pipeline = slot->mPipeline;
+		if (VK_NULL_HANDLE == pipeline) {
+			// Not ready yet => use the fallback, or bind nothing at all:
+			pipeline = slot->mFallback;
+			slot = findPipelineSlot(pipeline);
+			if (nullptr != slot) {
+				pipeline = slot->mPipeline;
+			}
+			if (VK_NULL_HANDLE == pipeline) {
+				return;
+			}
+		}
+	}
 	vkCmdBindPipeline(commandBuffer, pipelineBindPoint, pipeline);
+
+	// Restore the viewport and scissor of the current frame's command buffer if a pipeline with static state has invalidated them
+	// (other handles than slot handles, like vklGetBasicPipeline(), are expected to have dynamic viewport and scissor state):
+	if (VK_PIPELINE_BIND_POINT_GRAPHICS == pipelineBindPoint && !mSingleUseCommandBuffers.empty() && vk::CommandBuffer{ commandBuffer } == mSingleUseCommandBuffers.back().get()) {
+		const bool staticViewportAndScissor = nullptr != slot && slot->mStaticViewportAndScissor;
+		if (!staticViewportAndScissor && mStaticViewportAndScissorBound) {
+			setFramebufferViewportAndScissor(vk::CommandBuffer{ commandBuffer });
+		}
+		mStaticViewportAndScissorBound = staticViewportAndScissor;
+	}
+
+	// Keep vklCmdDispatch(Indirect) from skipping its bind if another pipeline has been bound into the compute command buffer:
+	if (VK_PIPELINE_BIND_POINT_COMPUTE == pipelineBindPoint && mComputeCommandBufferRecording && vk::CommandBuffer{ commandBuffer } == mComputeCommandBuffers.back().get()) {
+		mBoundComputePipeline = vk::Pipeline{ pipeline };
+	}
+}
+
+// Binds the current version of the given compute pipeline into the current compute command buffer (unless it is bound already), and returns the latter.
+vk::CommandBuffer bindComputePipeline(VkPipeline pipeline)
+{
+	if (!vklFrameworkInitialized()) {
+		VKL_EXIT_WITH_ERROR("Framework not initialized. Ensure to invoke vklInitFramework beforehand!");
+	}
+	const auto* slot = findPipelineSlot(pipeline);
+	if (nullptr == slot || vk::PipelineBindPoint::eCompute != slot->mBindPoint) {
+		VKL_EXIT_WITH_ERROR("Couldn't find the VkPipeline passed to vklCmdDispatch. Is it a valid handle and has it been created with vklCreateComputePipeline(...)?");
+	}
+	auto cb = getCurrentComputeCommandBuffer();
+	const auto computePipeline = vk::Pipeline{ slot->mPipeline };
+	if (mBoundComputePipeline != computePipeline) {
+		cb.bindPipeline(vk::PipelineBindPoint::eCompute, computePipeline);
+		mBoundComputePipeline = computePipeline;
+	}
+	return cb;
+}
+
+void vklCmdDispatch(VkPipeline pipeline, uint32_t group_count_x, uint32_t group_count_y, uint32_t group_count_z)
+{
+	bindComputePipeline(pipeline).dispatch(group_count_x, group_count_y, group_count_z);
+}
+
+void vklCmdDispatchIndirect(VkPipeline pipeline, VkBuffer buffer, VkDeviceSize offset)
+{
+	bindComputePipeline(pipeline).dispatchIndirect(vk::Buffer{ buffer }, offset);
 }
@@ -8,6 +8,7 @@
 #include <memory>
 #include <cstring>
 #include <vector>
+#include <string>
 #include <sstream>
 
 #define GLFW_INCLUDE_VULKAN
@@ -104,6 +105,64 @@ struct VklSwapchainConfig {
     std::vector<VklSwapchainFramebufferComposition> swapchainImages;
 };
 
+/*!
+ *	Optimization levels for the SPIR-V code which is generated from GLSL shaders.
+ */
+enum class VklShaderOptimizationLevel {
+    /*! The SPIR-V code is used as generated by the GLSL compiler. */
+    None,
+    /*! SPIRV-Tools' performance passes are run on the SPIR-V code (the same as spirv-opt -O). */
+    Performance,
+    /*! SPIRV-Tools' size passes are run on the SPIR-V code (the same as spirv-opt -Os). */
+    Size
+};
+
+/*!
+ *	A struct containing options for compiling GLSL shaders to SPIR-V.
+ *	All options are part of the shader cache key, i.e., different options never share cached SPIR-V.
+ */
+struct VklShaderCompileOptions {
+    /*!
+     *	Preprocessor macro definitions which are defined for all shader stages, given in the form "NAME" or "NAME=VALUE".
+     *	"NAME" is equivalent to "NAME=1". Use them to compile different permutations of the same shader code.
+     */
+    std::vector<std::string> macroDefinitions;
+
+    /*!
+     *	The Vulkan version to compile the shaders for, which also determines the SPIR-V version:
+     *	VK_API_VERSION_1_0 => SPIR-V 1.0, VK_API_VERSION_1_1 => SPIR-V 1.3, VK_API_VERSION_1_2 => SPIR-V 1.5,
+     *	VK_API_VERSION_1_3 => SPIR-V 1.6. Must not be higher than the Vulkan version of the instance and the device.
+     */
+    uint32_t targetVulkanVersion = VK_API_VERSION_1_1;
+
+    /*!
+     *	Which optimization passes to run on the generated SPIR-V code. Optimization requires Vulkan Launchpad to be
+     *	built with the CMake option VKL_ENABLE_SPIRV_OPTIMIZER, otherwise the SPIR-V code is not optimized.
+     */
+    VklShaderOptimizationLevel optimizationLevel = VklShaderOptimizationLevel::None;
+
+    /*! If set to true, debug information (source code and line numbers) is added to the SPIR-V code, e.g., for shader debuggers. */
+    bool generateDebugInfo = false;
+
+    /*! If set to true, all debug information is removed from the SPIR-V code, including the names of variables, types, and functions. */
+    bool stripDebugInfo = false;
+};
+
+/*!
+ *	The value of a specialization constant, i.e., of a "layout(constant_id = ...) const" declaration in a shader.
+ *	Specialization constants are applied when creating a pipeline, i.e., the driver can constant-fold them
+ *	(e.g., unroll loops or remove disabled features), without the shader having to be compiled to SPIR-V again.
+ */
+struct VklSpecializationConstant {
+    /*! The constant_id of the constant in the shader. */
+    uint32_t constantId = 0;
+
+    /*! The 32 bits of the constant's value: the value of int and uint constants, 0 or 1 for bool constants.
+     *	For float constants, use vklFloatSpecializationConstant.
+     */
+    uint32_t value = 0;
+};
+
 /*!
  *	A struct containing config parameters for the creation of a graphics pipeline
  */
@@ -163,12 +222,360 @@ struct VklGraphicsPipelineConfig {
      */
     std::vector<VkDescriptorSetLayoutBinding> descriptorLayout;
 
+    /*!
+     *	Push constant ranges which are accessible in the shaders of this pipeline, e.g.,
+     *	{ .stageFlags = VK_SHADER_STAGE_VERTEX_BIT, .offset = 0, .size = sizeof(glm::mat4) }.
+     *
+     *	All pipelines with the same descriptorLayout (regardless of the order of its entries) and the same
+     *	push constant ranges share one pipeline layout, i.e., they are compatible for descriptor set binding.
+     */
+    std::vector<VkPushConstantRange> pushConstantRanges;
+
     /*! If set to true, the pipeline will be configured to have blending enabled, 
      *  where its blend factors are set as follows: 
      *    srcColorBlendFactor=VK_BLEND_FACTOR_SRC_ALPHA
      *    dstColorBlendFactor=VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA
      */
     bool enableAlphaBlending = false;
+
+    /*!
+     *	If set to true, viewport and scissor are dynamic state (VK_DYNAMIC_STATE_VIEWPORT and VK_DYNAMIC_STATE_SCISSOR),
+     *	i.e., the pipeline does not depend on the swap chain's resolution. vklStartRecordingCommands sets both to
+     *	the whole framebuffer; they can be changed with vkCmdSetViewport and vkCmdSetScissor, e.g., for split-screen rendering.
+     *	If set to false, the swap chain's resolution is baked into the pipeline as static viewport and scissor.
+     *	Binding such a pipeline invalidates the dynamic viewport and scissor. Therefore, vklCmdBindPipeline sets them to
+     *	the whole framebuffer again when a pipeline with dynamic state is bound afterwards into the command buffer of
+     *	vklStartRecordingCommands. Set custom ones after binding; in other command buffers, set them after every such switch.
+     */
+    bool dynamicViewportAndScissor = true;
+
+    /*! Options for compiling the shaders of this pipeline, like macro definitions and optimization settings. */
+    VklShaderCompileOptions shaderCompileOptions;
+
+    /*!
+     *	Values of the specialization constants of the vertex shader, e.g., { { 0, 4 }, { 1, VK_TRUE } }.
+     *	Constants which are not listed keep the default value given in the shader. Pipelines which only differ in their
+     *	specialization constants share the same compiled SPIR-V and shader module, and each of them is only created once.
+     */
+    std::vector<VklSpecializationConstant> vertexShaderSpecializationConstants;
+
+    /*! Values of the specialization constants of the fragment shader, see vertexShaderSpecializationConstants. */
+    std::vector<VklSpecializationConstant> fragmentShaderSpecializationConstants;
+
+    /*!
+     *	Precompiled SPIR-V code of the vertex shader, e.g., compiled at build time with the vkl_add_shaders CMake function.
+     *	If set, vertexShaderPath is ignored, and the shader is neither compiled nor hot-reloaded.
+     */
+    const uint32_t *vertexShaderSpirv = nullptr;
+
+    /*! The size of the code pointed to by vertexShaderSpirv in bytes, e.g., sizeof(my_shader_vert_spv). */
+    size_t vertexShaderSpirvSizeInBytes = 0;
+
+    /*!
+     *	Precompiled SPIR-V code of the fragment shader, e.g., compiled at build time with the vkl_add_shaders CMake function.
+     *	If set, fragmentShaderPath is ignored, and the shader is neither compiled nor hot-reloaded.
+     */
+    const uint32_t *fragmentShaderSpirv = nullptr;
+
+    /*! The size of the code pointed to by fragmentShaderSpirv in bytes, e.g., sizeof(my_shader_frag_spv). */
+    size_t fragmentShaderSpirvSizeInBytes = 0;
+};
+
+/*!
+ *	Configuration of a compute pipeline, see vklCreateComputePipeline.
+ *	The members have the same meaning as the corresponding members of VklGraphicsPipelineConfig.
+ */
+struct VklComputePipelineConfig {
+    /*! The path to the compute shader, which is resolved just like VklGraphicsPipelineConfig::vertexShaderPath. */
+    const char *computeShaderPath = nullptr;
+
+    /*!
+     *	This vector describes the layout of resources that are bound to the compute shader, e.g., storage buffers
+     *	with .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER and .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT.
+     */
+    std::vector<VkDescriptorSetLayoutBinding> descriptorLayout;
+
+    /*! Push constant ranges which are accessible in the compute shader. Layouts are shared just like those of graphics pipelines. */
+    std::vector<VkPushConstantRange> pushConstantRanges;
+
+    /*! Options for compiling the compute shader, like macro definitions and optimization settings. */
+    VklShaderCompileOptions shaderCompileOptions;
+
+    /*! Values of the specialization constants of the compute shader, e.g., to set the local work group size. */
+    std::vector<VklSpecializationConstant> computeShaderSpecializationConstants;
+
+    /*! Precompiled SPIR-V code of the compute shader. If set, computeShaderPath is ignored, and the shader is neither compiled nor hot-reloaded. */
+    const uint32_t *computeShaderSpirv = nullptr;
+
+    /*! The size of the code pointed to by computeShaderSpirv in bytes. */
+    size_t computeShaderSpirvSizeInBytes = 0;
+};
+
+/*!
+ *	A struct containing config parameters for the on-disk SPIR-V cache.
+ *	Compiled SPIR-V binaries are stored in the cache directory, addressed by a hash of
+ *	everything that influences the compilation result (shader source, shader stage,
+ *	compile options, and compiler version). If an entry exists for a shader, it is
+ *	loaded from disk and the GLSL compiler is not invoked at all.
+ */
+struct VklShaderCacheConfig {
+    /*! If set to false, shaders will always be compiled from their sources and nothing is written to disk. */
+    bool enabled = true;
+
+    /*! The directory where cached SPIR-V binaries are stored. It is created if it does not exist yet. */
+    const char *cacheDirectory = "vkl_shader_cache";
+
+    /*! The maximum total size of all cache entries in bytes. If exceeded, the least recently used
+     *	entries are deleted. Set to 0 for an unlimited cache size.
+     */
+    uint64_t maxCacheSizeInBytes = 64ull * 1024ull * 1024ull;
+};
+
+/*!
+ *	A struct containing statistics about the on-disk SPIR-V cache.
+ */
+struct VklShaderCacheStatistics {
+    /*! How many shaders have been loaded from the cache: */
+    uint32_t hits = 0;
+
+    /*! How many shaders had to be compiled because they were not in the cache: */
+    uint32_t misses = 0;
+
+    /*! How many cache entries have been deleted to stay within the configured size limit: */
+    uint32_t evictions = 0;
+
+    /*! Total time spent loading shaders from the cache, in seconds: */
+    double secondsSpentLoadingFromCache = 0.0;
+
+    /*! Total time spent compiling shaders which were not in the cache, in seconds: */
+    double secondsSpentCompiling = 0.0;
+};
+
+/*!
+ *	A struct containing config parameters for the in-memory shader module cache.
+ *	Compiled shaders and their VkShaderModules are kept in memory, and shared by all pipelines which use
+ *	the same shader code (or the same precompiled SPIR-V) for the same stage with the same compile options.
+ */
+struct VklShaderModuleCacheConfig {
+    /*! If set to false, shader modules are created for every pipeline, and destroyed right after it has been created. */
+    bool enabled = true;
+
+    /*! The maximum number of shader modules kept in memory. If exceeded, the least recently used ones are released.
+     *	Set to 0 for an unlimited number of shader modules.
+     */
+    uint32_t maxShaderModules = 256;
+
+    /*!
+     *	If set to true, VK_EXT_shader_module_identifier is used: Pipelines are created from the identifiers of their
+     *	shader modules first, which allows the driver to skip processing their SPIR-V if it finds them in the pipeline
+     *	cache. Only those which are not found are created from their shader modules.
+     *	Only set this to true if the VK_EXT_shader_module_identifier device extension and its shaderModuleIdentifier
+     *	feature, as well as the pipelineCreationCacheControl feature, have been enabled on the device passed to vklInitFramework.
+     */
+    bool useShaderModuleIdentifiers = false;
+};
+
+/*!
+ *	A struct containing statistics about the in-memory shader module cache.
+ */
+struct VklShaderModuleCacheStatistics {
+    /*! How many shader stages have been taken from the cache, i.e., have neither been compiled nor uploaded again: */
+    uint32_t hits = 0;
+
+    /*! How many shader stages had to be compiled (or loaded from the on-disk SPIR-V cache) and uploaded: */
+    uint32_t misses = 0;
+
+    /*! How many shader modules have been released to stay within the configured limit: */
+    uint32_t evictions = 0;
+
+    /*! How many pipelines have been created from shader module identifiers, without handing their SPIR-V to the driver: */
+    uint32_t pipelinesCreatedFromIdentifiers = 0;
+};
+
+/*!
+ *	A struct containing config parameters for the persistent pipeline cache.
+ *	All pipelines are created with a VkPipelineCache which is owned by the framework. It is seeded
+ *	from the cache file in vklInitFramework (if the file has been created by the same device and
+ *	driver), and written back to the cache file in vklDestroyFramework.
+ */
+struct VklPipelineCacheConfig {
+    /*! If set to false, the pipeline cache is neither loaded from nor stored to disk. */
+    bool enabled = true;
+
+    /*! The file where the pipeline cache's data is stored. Its directory is created if it does not exist yet. */
+    const char *cacheFilePath = "vkl_shader_cache/pipeline_cache.bin";
+
+    /*!
+     *	If set to true, VK_EXT_pipeline_creation_feedback is used to log the driver-reported creation time
+     *	of every pipeline, and whether it has been found in the pipeline cache.
+     *	Only set this to true if the device supports Vulkan 1.3, or if the VK_EXT_pipeline_creation_feedback
+     *	device extension has been enabled on the device passed to vklInitFramework.
+     */
+    bool reportCreationFeedback = false;
+};
+
+/*!
+ *	A struct containing statistics about pipeline creation with the framework's pipeline cache.
+ */
+struct VklPipelineCacheStatistics {
+    /*! The size of the data the pipeline cache has been seeded with, 0 if there was no compatible cache file: */
+    size_t loadedCacheSizeInBytes = 0;
+
+    /*! How many pipelines have been created: */
+    uint32_t pipelinesCreated = 0;
+
+    /*! For how many pipelines the driver has reported creation feedback: */
+    uint32_t pipelinesWithFeedback = 0;
+
+    /*! How many of the pipelines with creation feedback have been found in the pipeline cache: */
+    uint32_t cacheHits = 0;
+
+    /*! Total time spent in vkCreateGraphicsPipelines, in seconds: */
+    double secondsSpentCreatingPipelines = 0.0;
+};
+
+/*!
+ *	A struct containing a breakdown of the time spent from the beginning of vklInitFramework
+ *	until the first frame has been presented. All times are in milliseconds.
+ */
+struct VklStartupTimings {
+    /*! Time spent creating the debug utils messenger: */
+    double debugMessengerMilliseconds = 0.0;
+
+    /*! Time spent creating the swapchain image views and the depth images and their views: */
+    double imageViewsMilliseconds = 0.0;
+
+    /*! Time spent creating the render pass: */
+    double renderPassMilliseconds = 0.0;
+
+    /*! Time spent creating the framebuffers: */
+    double framebuffersMilliseconds = 0.0;
+
+    /*! Time spent creating semaphores and fences: */
+    double syncObjectsMilliseconds = 0.0;
+
+    /*! Time spent loading the pipeline cache file and creating the pipeline cache: */
+    double pipelineCacheMilliseconds = 0.0;
+
+    /*! Time spent creating the command pool: */
+    double commandPoolMilliseconds = 0.0;
+
+    /*! Total time spent in vklInitFramework: */
+    double initFrameworkMilliseconds = 0.0;
+
+    /*! Time spent creating graphics pipelines (including shader compilation) before the first frame has been presented: */
+    double pipelinesMilliseconds = 0.0;
+
+    /*! Time spent initializing the runtime shader compiler, which is only done once GLSL code actually has to be compiled: */
+    double shaderCompilerInitializationMilliseconds = 0.0;
+
+    /*! Time from the beginning of vklInitFramework until the first frame has been presented, 0 until then: */
+    double timeToFirstFrameMilliseconds = 0.0;
+};
+
+/*!
+ *	A struct containing config parameters for the framework's built-in memory allocator, which is used for all
+ *	buffers and images created with backing memory, unless a VMA allocator has been passed to vklInitFramework.
+ *	Resources are sub-allocated from large blocks of device memory, one set of blocks per memory type. Buffers
+ *	and images never share a block, so that they never violate the device's bufferImageGranularity.
+ */
+struct VklMemoryAllocatorConfig {
+    /*! If set to false, memory is allocated separately for every buffer and image. */
+    bool enabled = true;
+
+    /*! The size of every block of device memory. Resources larger than half of it get memory of their own. */
+    VkDeviceSize blockSizeInBytes = 64ull * 1024ull * 1024ull;
+
+    /*!
+     *	If set to true, resources are allocated from linear blocks, i.e., one after the other like from a stack.
+     *	The memory of a linear block is only reused once all resources allocated from it have been destroyed.
+     *	This is the fastest way of allocating resources which are destroyed together, e.g., the resources of a level:
+     *	Set it to true before creating them, and back to false afterwards.
+     */
+    bool linear = false;
+};
+
+/*!
+ *	A struct containing statistics about the framework's built-in memory allocator.
+ */
+struct VklMemoryAllocatorStatistics {
+    /*! How many blocks of device memory are currently allocated: */
+    uint32_t blockCount = 0;
+
+    /*! How many resources are currently sub-allocated from blocks: */
+    uint32_t subAllocationCount = 0;
+
+    /*! How many resources currently have memory of their own: */
+    uint32_t dedicatedAllocationCount = 0;
+
+    /*! Total size of all device memory allocated, i.e., of all blocks and of all separate allocations: */
+    VkDeviceSize allocatedBytes = 0;
+
+    /*! Total size of the memory actually used by resources, which is lower than allocatedBytes due to free ranges in blocks: */
+    VkDeviceSize usedBytes = 0;
+};
+
+/*!
+ *	A struct containing config parameters for uploads into device-local buffers (see vklUploadToDeviceLocalBuffer).
+ *	Data is staged in a persistently mapped ring buffer, whose space is reused once the frames which uploaded from it are done.
+ */
+struct VklStagingConfig {
+    /*!
+     *	The size of the staging ring. If an upload does not fit into the part of the ring which is not in use by frames
+     *	in flight, the CPU waits for the device to finish all submitted work. Larger uploads are split into multiple parts.
+     */
+    VkDeviceSize ringSizeInBytes = 32ull * 1024ull * 1024ull;
+};
+
+/*!
+ *	A struct containing config parameters for asynchronous uploads (see vklUploadToDeviceLocalBufferAsync).
+ *	Asynchronous uploads require timeline semaphores, i.e., the timelineSemaphore feature of Vulkan 1.2 must have been
+ *	enabled on the device passed to vklInitFramework. On Vulkan 1.1 devices, the VK_KHR_timeline_semaphore device
+ *	extension and its timelineSemaphore feature must have been enabled instead.
+ */
+struct VklTransferQueueConfig {
+    /*!
+     *	A queue which asynchronous uploads are submitted to, e.g., one of a transfer-only queue family, so that
+     *	uploads overlap with rendering. If VK_NULL_HANDLE, they are submitted to the queue passed to vklInitFramework.
+     */
+    VkQueue transferQueue = VK_NULL_HANDLE;
+
+    /*! The queue family of transferQueue: */
+    uint32_t transferQueueFamilyIndex = 0;
+
+    /*!
+     *	The queue family of the queue passed to vklInitFramework. If it differs from transferQueueFamilyIndex, the
+     *	ownership of uploaded buffer ranges and image subresources is transferred to it.
+     */
+    uint32_t graphicsQueueFamilyIndex = 0;
+};
+
+/*!
+ *	Identifies an asynchronous upload. It is the value which the upload signals on the timeline semaphore
+ *	returned by vklGetUploadTimelineSemaphore, i.e., a later upload always has a larger token.
+ */
+using VklUploadToken = uint64_t;
+
+/*!
+ *	A struct containing config parameters for the per-frame uniform allocator (see vklAllocateUniformData).
+ */
+struct VklUniformAllocatorConfig {
+    /*! How much uniform data can be allocated per frame. The allocator's buffer has one such region per frame in flight. */
+    VkDeviceSize bytesPerFrame = 4ull * 1024ull * 1024ull;
+};
+
+/*!
+ *	A range of transient uniform data, allocated with vklAllocateUniformData, which is valid for the current frame only.
+ */
+struct VklUniformAllocation {
+    /*! The allocator's buffer, which is the same for all allocations (see vklGetUniformAllocatorBuffer): */
+    VkBuffer buffer = VK_NULL_HANDLE;
+
+    /*! Offset of the range within buffer, aligned to minUniformBufferOffsetAlignment. Pass it as dynamic offset: */
+    VkDeviceSize offset = 0;
+
+    /*! Pointer to the range's persistently mapped, host-coherent memory, which the uniform data can be written to: */
+    void *mappedPointer = nullptr;
 };
 
 /*!
@@ -279,16 +686,22 @@ void vklEndRecordingCommands();
  * The settings taken from the configuration struct are the following:
  *  - ::vertexShaderPath ............. A path to a text file containing GLSL vertex shader code. If loadShadersFromMemory is true, then this is treated as the vertex shader code itself, not a path to it.
  *	- ::fragmentShaderPath ........... A path to a text file containing GLSL fragment shader code. If loadShadersFromMemory is true, then this is treated as the fragment shader code itself, not a path to it.
+ *	                                   Shaders can #include other files. "..." includes are resolved relative to the including file, <...> includes
+ *	                                   relative to the shader file (or, if loadShadersFromMemory is true, relative to the working directory).
  *	- ::vertexInputBuffers ........... A list of descriptions for the structure of buffers, which contain data for vertex input attributes.
  *	- ::inputAttributeDescriptions ... A list of descriptions for vertex input attributes, and where the data can be found in ::vertexInputBuffers.
  *  - ::polygonDrawMode .............. How the graphics pipeline shall draw the input polygons.
  *	- ::descriptorLayout ............. A list of resource descriptors. Can be used for, e.g., describing where shaders can find uniform buffers.
+ *	- ::pushConstantRanges ........... A list of push constant ranges which can be used in the shaders.
+ *	- ::vertexShaderSpecializationConstants, ::fragmentShaderSpecializationConstants
+ *	                                   Values of specialization constants, which are applied without compiling the shaders again.
  *
  * Settings which are configured to default values internally are the following:
  *  - The topology of the input data is expected to be a triangle list, i.e., VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST.
  *	- The viewport is set to (0, 0) -- (width, height), where width and height refer to the swap chain's width and height.
  *	- Min- and max depth values are set to 0.0, and 1.0, respectively.
  *	- Scissors are set to (0, 0) -- (width, height), where width and height refer to the swap chain's width and height.
+ *	- Viewport and scissors are dynamic state, which is set by vklStartRecordingCommands, unless ::dynamicViewportAndScissor is false.
  *	- The line width is set to 1.0
  *	- The culling mode is set to cull back-facing primitives, i.e., VK_CULL_MODE_BACK_BIT.
  *	- The front faces are set to be given in counter-clockwise winding order, i.e., VK_FRONT_FACE_COUNTER_CLOCKWISE.
@@ -301,18 +714,226 @@ void vklEndRecordingCommands();
  *
  *	@param	config		Configuration struct containing the non-default settings described above.
  *	@param loadShadersFromMemory If true, then the shader paths of the config struct are interpreted as shader code.
- *	@return On success, a valid VkPipeline handle is returned.
+ *	@return On success, a pipeline handle is returned, which refers to the most recent (e.g., hot-reloaded) version of the pipeline.
+ *			It must only be used with the framework's functions (i.e., vklCmdBindPipeline, vklBindDescriptorSetToPipeline,
+ *			vklGetLayoutForPipeline, vklDestroyGraphicsPipeline), but never with Vulkan functions directly.
+ *			Identical configs (including the contents of their shaders) yield the same, shared handle, which is reference-counted:
+ *			It must be passed to vklDestroyGraphicsPipeline once per call to this function.
  */
 VkPipeline vklCreateGraphicsPipeline(const VklGraphicsPipelineConfig &config, bool loadShadersFromMemory = false);
 
+/*!
+ *	Creates multiple graphics pipelines at once, each with the same defaults as vklCreateGraphicsPipeline.
+ *	Shader stages which are shared by multiple configs (same file or code, same stage, same compile options)
+ *	are compiled only once, and all stages are compiled concurrently on the worker threads.
+ *	All pipelines are then created with a single vkCreateGraphicsPipelines call, which drivers can parallelize internally.
+ *	Prefer this function over multiple calls to vklCreateGraphicsPipeline when creating many pipelines, e.g., when loading a level.
+ *
+ *	@param	configs		Configuration structs, one for each pipeline to be created.
+ *	@param loadShadersFromMemory If true, then the shader paths of all config structs are interpreted as shader code.
+ *	@return The pipeline handles in the same order as the configs, which are used just like those returned by vklCreateGraphicsPipeline.
+ *			Each of them can be destroyed with vklDestroyGraphicsPipeline.
+ */
+std::vector<VkPipeline> vklCreateGraphicsPipelines(const std::vector<VklGraphicsPipelineConfig> &configs, bool loadShadersFromMemory = false);
+
+/*!
+ *	Creates a graphics pipeline (with the same defaults as vklCreateGraphicsPipeline) without blocking:
+ *	A handle is returned immediately, while the shaders are compiled and the pipeline is created on the worker threads.
+ *	The pipeline is swapped in at the beginning of the first frame after it is ready. Until then, vklCmdBindPipeline
+ *	binds the fallback pipeline instead, or nothing at all if the fallback is VK_NULL_HANDLE (use vklIsPipelineReady
+ *	to skip the respective draw calls in this case).
+ *
+ *	Just like the handles returned by vklCreateGraphicsPipeline, the handle must only be used with the framework's functions
+ *	(i.e., vklCmdBindPipeline, vklBindDescriptorSetToPipeline, vklGetLayoutForPipeline, vklDestroyGraphicsPipeline),
+ *	but never with Vulkan functions directly. Its pipeline layout is available right away. The fallback pipeline should have a compatible pipeline layout.
+ *
+ *	@param	config		Configuration struct, just like for vklCreateGraphicsPipeline.
+ *	@param	fallbackPipeline	The pipeline to bind until the pipeline is ready, e.g., vklGetBasicPipeline(), or VK_NULL_HANDLE.
+ *	@param loadShadersFromMemory If true, then the shader paths of the config struct are interpreted as shader code.
+ *	@return A handle for the pipeline.
+ */
+VkPipeline vklCreateGraphicsPipelineAsync(const VklGraphicsPipelineConfig &config, VkPipeline fallbackPipeline = VK_NULL_HANDLE, bool loadShadersFromMemory = false);
+
+/*!
+ *	Creates a compute pipeline. Its shader is compiled and cached just like the shaders of graphics pipelines, and
+ *	the pipeline is hot-reloaded together with graphics pipelines (see vklHotReloadPipelines and vklEnableShaderFileWatching).
+ *	Just like the handles of graphics pipelines, the handle must only be used with the framework's functions, i.e., with
+ *	vklCmdDispatch, vklCmdDispatchIndirect, vklBindDescriptorSetToPipeline, vklGetLayoutForPipeline, and vklDestroyComputePipeline.
+ *
+ *	@param	config		Configuration struct containing the compute shader and the layout of its resources.
+ *	@param loadShaderFromMemory If true, then the shader path of the config struct is interpreted as shader code.
+ *	@return On success, a handle to the compute pipeline is returned.
+ */
+VkPipeline vklCreateComputePipeline(const VklComputePipelineConfig &config, bool loadShaderFromMemory = false);
+
+/*!
+ *	Destroys a compute pipeline that has been created with vklCreateComputePipeline.
+ *
+ *	@param	pipeline	A valid handle to a compute pipeline. The pipeline will be unusable after this function has returned.
+ */
+void vklDestroyComputePipeline(VkPipeline pipeline);
+
+/*!
+ *	Enables graphics pipeline libraries (VK_EXT_graphics_pipeline_library) for all graphics pipelines that are created
+ *	afterwards, except for those created with vklCreateGraphicsPipelines. Must be invoked before vklInitFramework.
+ *	Pipelines are then linked from four libraries (vertex input interface, pre-rasterization shaders, fragment shader,
+ *	and fragment output interface), each of which is cached and shared between pipelines with the same state. Pipelines are
+ *	fast-linked first, and linked with link-time optimization on the worker threads afterwards. The optimized pipelines are
+ *	swapped in at frame boundaries. Thus, hot-reloading a fragment shader only requires creating its library and a fast link.
+ *
+ *	The VK_EXT_graphics_pipeline_library and VK_KHR_pipeline_library device extensions and the graphicsPipelineLibrary
+ *	feature must have been enabled on the device passed to vklInitFramework. If the physical device does not support them,
+ *	a warning is printed and pipelines are created without libraries.
+ *
+ *	@param	enable		Whether to use graphics pipeline libraries.
+ */
+void vklEnableGraphicsPipelineLibrary(bool enable);
+
+/*!
+ *	Returns true if graphics pipeline libraries have been enabled with vklEnableGraphicsPipelineLibrary and are supported by the device.
+ */
+bool vklIsGraphicsPipelineLibraryInUse();
+
+/*!
+ *	Returns false while a pipeline created with vklCreateGraphicsPipelineAsync is still being created, or if its creation has
+ *	failed (then it is retried after its shader files have changed and vklHotReloadPipelines has been invoked). Returns true otherwise.
+ */
+bool vklIsPipelineReady(VkPipeline pipeline);
+
+/*!
+ *	Starts recording the configs of all graphics pipelines which are created from now on (with vklCreateGraphicsPipeline,
+ *	vklCreateGraphicsPipelines, or vklCreateGraphicsPipelineAsync), along with the hashes of their shaders, into a pipeline
+ *	manifest. The manifest is written to the given file in vklDestroyFramework, and can be passed to vklPrewarmPipelines
+ *	in the next session. Pipelines with precompiled shaders or immutable samplers are not recorded.
+ *
+ *	@param	manifest_path	The file to write the manifest to, or nullptr to stop recording (then, nothing is written).
+ */
+void vklRecordPipelineManifest(const char *manifest_path);
+
+/*!
+ *	Creates all graphics pipelines which have been recorded in the given pipeline manifest on the worker threads, with the
+ *	current contents of their shader files. Once a pipeline with a matching config is requested with vklCreateGraphicsPipeline,
+ *	the prewarmed pipeline is handed out (after waiting for it, if it is still being created) instead of creating it.
+ *	Prewarmed pipelines which are never requested are destroyed in vklDestroyFramework.
+ *	Call this function after vklInitFramework, and as early as possible.
+ *
+ *	@param	manifest_path	The file which a manifest has been written to in an earlier session, see vklRecordPipelineManifest.
+ *	@return The number of pipelines which are being prewarmed.
+ */
+uint32_t vklPrewarmPipelines(const char *manifest_path);
+
 /*!
  *	Destroys a graphics pipeline that has been previously created with vklCreateGraphicsPipeline.
+ *	If the handle is shared between multiple vklCreateGraphicsPipeline calls with identical configs,
+ *	only one reference is released, and the pipeline is destroyed when the last reference is released.
  *
  *	@param	pipeline	A valid handle to a graphics pipeline that has been created with vklCreateGraphicsPipeline.
  *						The pipeline will be unusable after this function has returned. 
  */
 void vklDestroyGraphicsPipeline(VkPipeline pipeline);
 
+/*!
+ *	Creates the value of a specialization constant which is declared as float in the shader.
+ *
+ *	@param	constant_id		The constant_id of the constant in the shader.
+ *	@param	value			The constant's value.
+ *	@return	The specialization constant to add to vertexShaderSpecializationConstants or fragmentShaderSpecializationConstants.
+ */
+VklSpecializationConstant vklFloatSpecializationConstant(uint32_t constant_id, float value);
+
+/*!
+ *	Configures the on-disk SPIR-V cache which is used whenever GLSL shader code is compiled.
+ *	The cache is enabled by default. Call this function before creating any pipelines,
+ *	i.e., ideally before vklInitFramework, for the settings to apply to all shaders.
+ *
+ *	@param	config		The cache directory, its size limit, and whether the cache is enabled at all.
+ */
+void vklConfigureShaderCache(const VklShaderCacheConfig &config);
+
+/*!
+ *	Returns statistics about the on-disk SPIR-V cache, i.e., how many shaders have been loaded
+ *	from the cache vs. compiled, and how much time has been spent on either.
+ */
+VklShaderCacheStatistics vklGetShaderCacheStatistics();
+
+/*!
+ *	Configures the in-memory shader module cache, which is enabled by default.
+ *	Call this function before vklInitFramework for the settings to apply.
+ *
+ *	@param	config		Whether the cache is enabled, its size limit, and whether shader module identifiers shall be used.
+ */
+void vklConfigureShaderModuleCache(const VklShaderModuleCacheConfig &config);
+
+/*!
+ *	Returns statistics about the in-memory shader module cache, i.e., how many shader stages have been
+ *	reused vs. compiled and uploaded, and how many pipelines have been created from shader module identifiers.
+ */
+VklShaderModuleCacheStatistics vklGetShaderModuleCacheStatistics();
+
+/*!
+ *	Releases all shader modules in the in-memory shader module cache, e.g., after loading a level.
+ *	Shader modules which are still being used for creating pipelines are destroyed once these have been created.
+ */
+void vklPurgeShaderModuleCache();
+
+/*!
+ *	Configures the persistent pipeline cache, which is enabled by default.
+ *	Call this function before vklInitFramework for the settings to apply.
+ *
+ *	@param	config		The cache file, whether it is used at all, and whether creation feedback shall be reported.
+ */
+void vklConfigurePipelineCache(const VklPipelineCacheConfig &config);
+
+/*!
+ *	Returns statistics about pipeline creation, i.e., how many pipelines have been created, how
+ *	long that took, and (if creation feedback is enabled) how many have been found in the pipeline cache.
+ */
+VklPipelineCacheStatistics vklGetPipelineCacheStatistics();
+
+/*!
+ *	Returns how long the individual phases of vklInitFramework took, and how long it took until
+ *	the first frame was presented. The breakdown is also logged once the first frame has been presented.
+ */
+VklStartupTimings vklGetStartupTimings();
+
+/*!
+ *	Configures the built-in memory allocator, which is enabled by default.
+ *	Settings apply to all buffers and images created after this call.
+ *
+ *	@param	config		Whether the allocator is enabled, the size of its blocks, and whether blocks are allocated from linearly.
+ */
+void vklConfigureMemoryAllocator(const VklMemoryAllocatorConfig &config);
+
+/*!
+ *	Returns statistics about the built-in memory allocator, i.e., how many blocks of device memory it has
+ *	allocated, and how many resources have been sub-allocated from them.
+ */
+VklMemoryAllocatorStatistics vklGetMemoryAllocatorStatistics();
+
+/*!
+ *	Configures the staging ring for uploads into device-local buffers.
+ *	Call this function before the first upload for the settings to apply, since the ring is created on first use.
+ *
+ *	@param	config		The size of the staging ring.
+ */
+void vklConfigureStaging(const VklStagingConfig &config);
+
+/*!
+ *	Configures the queue which asynchronous uploads are submitted to.
+ *	Call this function before the first asynchronous upload for the settings to apply.
+ *
+ *	@param	config		The transfer queue, and the queue families of the transfer queue and of the queue passed to vklInitFramework.
+ */
+void vklConfigureTransferQueue(const VklTransferQueueConfig &config);
+
+/*!
+ *	Configures the per-frame uniform allocator.
+ *	Call this function before the first allocation for the settings to apply, since the allocator's buffer is created on first use.
+ *
+ *	@param	config		How much uniform data can be allocated per frame.
+ */
+void vklConfigureUniformAllocator(const VklUniformAllocatorConfig &config);
+
 /*!
  *  Allocates host-coherent memory that fits the given requirements.
  *
@@ -386,6 +1007,39 @@ void vklCopyDataIntoHostCoherentBuffer(VkBuffer buffer, const void *data_pointer
 void vklCopyDataIntoHostCoherentBuffer(VkBuffer buffer, size_t buffer_offset_in_bytes, const void *data_pointer,
                                        size_t data_size_in_bytes);
 
+/*!
+ *	One range of data to be copied into a host coherent buffer, see vklCopyDataIntoHostCoherentBuffer.
+ */
+struct VklBufferCopyRange {
+    /*! Offset from the beginning of the buffer, where to start copying data to: */
+    size_t bufferOffsetInBytes = 0;
+
+    /*! Pointer to the beginning of CPU-side data: */
+    const void *dataPointer = nullptr;
+
+    /*! How many bytes shall be copied from the memory address at dataPointer into the buffer: */
+    size_t dataSizeInBytes = 0;
+};
+
+/*!
+ *	Copies multiple ranges of data into the buffer at once, e.g., the uniform data of all objects of a frame.
+ *
+ *	@param	buffer		Host coherent buffer to copy data into.
+ *	@param	ranges		The ranges of data to be copied, and where to copy them to.
+ */
+void vklCopyDataIntoHostCoherentBuffer(VkBuffer buffer, const std::vector<VklBufferCopyRange> &ranges);
+
+/*!
+ *	Returns a pointer to the memory of a buffer which has been created with vklCreateHostCoherentBufferWithBackingMemory.
+ *	The memory of such buffers stays mapped until they are destroyed, so data can be written through the pointer
+ *	directly, e.g., per-frame uniform data, without mapping or copying through vklCopyDataIntoHostCoherentBuffer.
+ *	The memory is host-coherent, i.e., writes become visible to the device without flushing.
+ *
+ *	@param	buffer		Host coherent buffer to get the mapped memory of.
+ *	@return	A pointer to the beginning of the buffer's memory.
+ */
+void* vklGetMappedPointer(VkBuffer buffer);
+
 /*!
  * Create a new host coherent buffer on the GPU, upload the supplied data from the vector, and return the buffer handle.
  *
@@ -400,16 +1054,140 @@ void vklCopyDataIntoHostCoherentBuffer(VkBuffer buffer, size_t buffer_offset_in_
 VkBuffer vklCreateHostCoherentBufferAndUploadData(const void* data, size_t size, VkBufferUsageFlags usageFlags);
 
 /*!
- *	Binds the given descriptor set for the given graphics pipeline (internally using vkCmdBindDescriptorSets).
+ *	Uploads data into a device-local buffer, e.g., one created with vklCreateDeviceLocalBufferWithBackingMemory and
+ *	VK_BUFFER_USAGE_TRANSFER_DST_BIT. The data is copied into a staging ring right away, i.e., data_pointer does not
+ *	have to stay valid. All uploads are recorded into one command buffer per frame in vklEndRecordingCommands, which
+ *	is executed before the frame's compute and rendering work, so the data can be used by the same frame already.
+ *
+ *	@param	dst_buffer				Device-local buffer to upload data into.
+ *	@param	dst_offset_in_bytes		Offset from the beginning of dst_buffer, where to start copying data to.
+ *	@param	data_pointer			Pointer to the beginning of CPU-side data.
+ *	@param	data_size_in_bytes		How many bytes shall be copied from the memory address at data_pointer into the buffer?
+ */
+void vklUploadToDeviceLocalBuffer(VkBuffer dst_buffer, VkDeviceSize dst_offset_in_bytes, const void *data_pointer, VkDeviceSize data_size_in_bytes);
+
+/*!
+ * Create a new device-local buffer on the GPU, upload the supplied data into it (see vklUploadToDeviceLocalBuffer), and return the buffer handle.
+ *
+ * Be sure to free the allocated memory by calling `vklDestroyDeviceLocalBufferAndItsBackingMemory(...)` on the returned handle once the
+ * buffer is no longer required.
+ *
+ * @param data Pointer to the data to upload to the GPU.
+ * @param size Size of the data in bytes.
+ * @param usageFlags Usage flags to use when creating the buffer.
+ * @return The handle of the newly generated buffer.
+ */
+VkBuffer vklCreateDeviceLocalBufferAndUploadData(const void* data, size_t size, VkBufferUsageFlags usageFlags);
+
+/*!
+ *	Uploads data into a device-local buffer asynchronously, i.e., on the transfer queue (see vklConfigureTransferQueue),
+ *	so that streaming data overlaps with rendering. The data is copied into a staging buffer right away, i.e.,
+ *	data_pointer does not have to stay valid. The buffer range must not be used until the upload has completed,
+ *	i.e., only in frames recorded after vklIsUploadComplete has returned true for the returned token, or in frames
+ *	which wait for the upload (see vklWaitForUploadInCurrentFrame). It is acquired by the graphics queue family in
+ *	the first such frame.
+ *
+ *	@param	dst_buffer				Device-local buffer to upload data into, created with VK_BUFFER_USAGE_TRANSFER_DST_BIT.
+ *	@param	dst_offset_in_bytes		Offset from the beginning of dst_buffer, where to start copying data to.
+ *	@param	data_pointer			Pointer to the beginning of CPU-side data.
+ *	@param	data_size_in_bytes		How many bytes shall be copied from the memory address at data_pointer into the buffer?
+ *	@return	A token which identifies the upload.
+ */
+VklUploadToken vklUploadToDeviceLocalBufferAsync(VkBuffer dst_buffer, VkDeviceSize dst_offset_in_bytes, const void *data_pointer, VkDeviceSize data_size_in_bytes);
+
+/*!
+ *	Uploads data into one mip level of one array layer of a color image asynchronously, just like vklUploadToDeviceLocalBufferAsync.
+ *	The previous contents of the subresource are discarded, and it is in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+ *	once it has been acquired by the graphics queue family.
+ *
+ *	@param	dst_image				Device-local image to upload data into, created with VK_IMAGE_USAGE_TRANSFER_DST_BIT.
+ *	@param	width					Width of the mip level in texels.
+ *	@param	height					Height of the mip level in texels.
+ *	@param	mip_level				The mip level to upload data into.
+ *	@param	array_layer				The array layer to upload data into.
+ *	@param	data_pointer			Pointer to the beginning of CPU-side data, tightly packed in the image's format.
+ *	@param	data_size_in_bytes		Size of the data in bytes.
+ *	@return	A token which identifies the upload.
+ */
+VklUploadToken vklUploadToDeviceLocalImageAsync(VkImage dst_image, uint32_t width, uint32_t height, uint32_t mip_level, uint32_t array_layer, const void *data_pointer, VkDeviceSize data_size_in_bytes);
+
+/*!
+ *	Returns true if the asynchronous upload with the given token has completed. Its resource can be used
+ *	by all frames which are recorded from then on.
+ */
+bool vklIsUploadComplete(VklUploadToken token);
+
+/*!
+ *	Blocks until the asynchronous upload with the given token has completed, e.g., while showing a loading screen.
+ */
+void vklWaitForUpload(VklUploadToken token);
+
+/*!
+ *	Makes the device wait for the asynchronous upload with the given token before it executes the current frame's
+ *	work, so that its resource can be used in the current frame already, without blocking the CPU.
+ *	Call this function between vklWaitForNextSwapchainImage and vklEndRecordingCommands.
+ */
+void vklWaitForUploadInCurrentFrame(VklUploadToken token);
+
+/*!
+ *	Returns the timeline semaphore which asynchronous uploads signal their tokens on, e.g., for waiting
+ *	for them in own queue submissions. VK_NULL_HANDLE until the first asynchronous upload.
+ */
+VkSemaphore vklGetUploadTimelineSemaphore();
+
+/*!
+ *	Binds the given descriptor set for the given graphics or compute pipeline (internally using vkCmdBindDescriptorSets).
  *	To be more precise: The VkPipelineLayout of the given VkPipeline is retrieved and the descriptor is bound for that.
+ *	Descriptor sets of graphics pipelines are bound into vklGetCurrentCommandBuffer(), those of compute pipelines
+ *	into vklGetCurrentComputeCommandBuffer().
+ *
+ *	Pipelines with identical descriptorLayout and pushConstantRanges share the same pipeline layout. If the given
+ *	descriptor set has already been bound with the same layout (via this function, since vklStartRecordingCommands),
+ *	binding it again is skipped, since switching between such pipelines does not disturb it.
+ *	Bind descriptor sets either always via this function or never during one frame, otherwise the tracked state is stale.
  *
  *	@param	descriptor_set		This handle must represent a valid descriptor set.
- *								It will be bound to the VK_PIPELINE_BIND_POINT_GRAPHICS binding point.
- *	@param	pipeline			This handle must represent a valid graphics pipeline that has been created with 
- *								vklCreateGraphicsPipeline previously. Internally, its pipeline layout will be used.
+ *								It will be bound to the VK_PIPELINE_BIND_POINT_GRAPHICS binding point for graphics pipelines,
+ *								and to the VK_PIPELINE_BIND_POINT_COMPUTE binding point for compute pipelines.
+ *	@param	pipeline			This handle must represent a valid pipeline that has been created with vklCreateGraphicsPipeline
+ *								or vklCreateComputePipeline previously. Internally, its pipeline layout will be used.
  */
 void vklBindDescriptorSetToPipeline(VkDescriptorSet descriptor_set, VkPipeline pipeline);
 
+/*!
+ *	Binds the given descriptor set for the given graphics or compute pipeline, just like the overload above, with dynamic
+ *	offsets for its dynamic descriptors, e.g., of type VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC. This way, one descriptor
+ *	set can serve all draw calls, each with its own uniform data (see vklAllocateUniformData).
+ *	The descriptor set is bound again whenever any of the dynamic offsets changes.
+ *
+ *	@param	descriptor_set		This handle must represent a valid descriptor set.
+ *	@param	pipeline			This handle must represent a valid pipeline that has been created with vklCreateGraphicsPipeline
+ *								or vklCreateComputePipeline previously. Internally, its pipeline layout will be used.
+ *	@param	dynamic_offsets		One offset per dynamic descriptor of the descriptor set, in the order of their bindings.
+ */
+void vklBindDescriptorSetToPipeline(VkDescriptorSet descriptor_set, VkPipeline pipeline, const std::vector<uint32_t> &dynamic_offsets);
+
+/*!
+ *	Allocates a range of transient uniform data for the current frame from a persistently mapped buffer, instead of
+ *	creating a buffer per object. Allocations are bump-allocated from the current frame in flight's region of the buffer,
+ *	which is reset once the frame's fence has been waited for in vklWaitForNextSwapchainImage, i.e., they are only valid
+ *	for the current frame. Call this function between vklWaitForNextSwapchainImage and vklEndRecordingCommands.
+ *
+ *	Typically, a descriptor set with a VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC descriptor is written once, for the buffer
+ *	returned by vklGetUniformAllocatorBuffer, and bound with the offset of every draw call's allocation as dynamic offset.
+ *
+ *	@param	size_in_bytes		Size of the uniform data in bytes.
+ *	@param	data_pointer		If not nullptr, size_in_bytes bytes are copied from this address into the allocation.
+ *	@return	The allocator's buffer, the allocation's offset within it, and a pointer to its mapped memory.
+ */
+VklUniformAllocation vklAllocateUniformData(VkDeviceSize size_in_bytes, const void *data_pointer = nullptr);
+
+/*!
+ *	Returns the buffer which vklAllocateUniformData allocates from. It stays the same until vklDestroyFramework,
+ *	i.e., descriptors which refer to it only have to be written once.
+ */
+VkBuffer vklGetUniformAllocatorBuffer();
+
 /*!
  *	Creates a 2D image (VkImage) of the given size, in the given format, and for the given usage(s) on the device.
  *	Also creates backing memory (VkDeviceMemory) for that image in device local memory (VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT).
@@ -548,7 +1326,8 @@ VkCommandBuffer vklGetCurrentCommandBuffer();
 
 /*!
  *  Returns the basic vulkan pipeline automatically set up by the
- *  framework.
+ *  framework. The pipeline is created on first use, from SPIR-V which
+ *  has been embedded at build time if glslangValidator was available.
  */
 VkPipeline vklGetBasicPipeline();
 
@@ -645,10 +1424,26 @@ glm::mat4 vklCreatePerspectiveProjectionMatrix(float field_of_view, float aspect
 VklGeometryData vklLoadModelGeometry(const std::string& path_to_obj);
 
 /*!
- *  Triggers the unconditional hot-reloading of all known graphics pipelines.
+ *  Triggers the hot-reloading of all known graphics and compute pipelines, of which any shader file or any file that
+ *  is #included by their shaders has changed (i.e., has a different modification time AND different contents).
+ *  Pipelines whose files have not changed are not recompiled. The shaders of all pipelines are compiled in parallel on worker threads, and the calling thread
+ *  is not blocked. Every reloaded pipeline is swapped in at the beginning of the first frame (i.e., during
+ *  vklWaitForNextSwapchainImage) after it has finished compiling, in the order in which the reloads have been triggered.
+ *  Hence, the pipelines of one reload may be swapped in during different frames.
+ *  If a shader fails to compile, the previous version of its pipeline remains in use.
  */
 void vklHotReloadPipelines();
 
+/*!
+ *  Sets the number of worker threads which are used for compiling shaders and creating pipelines in parallel.
+ *  Waits for all jobs which are currently being processed by the worker threads before returning.
+ *
+ *  @param  thread_count            The number of worker threads. Pass 0 (default) to use one worker thread per
+ *                                  hardware thread. Pass 1 to compile everything sequentially on one worker thread,
+ *                                  which can be useful to compare against the timings of parallel compilation.
+ */
+void vklSetWorkerThreadCount(uint32_t thread_count);
+
 /*!
  *  Enables graphics pipeline hot-reloading to be triggered by users through a defined keyboard shortcut.
  *  Pipeline hot-reloading can be super helpful during shader development. Pipelines containing the updated
@@ -671,10 +1466,33 @@ void vklHotReloadPipelines();
 void vklEnablePipelineHotReloading(GLFWwindow* glfw_window, int glfw_key, int glfw_modifier_keys = 0);
 
 /*!
- *  Replacement function for the Vulkan API's vkCmdBindPipeline function, adding support for pipeline hot-reloading,
- *  by using the most up-to-date version of possibly hot-reloaded pipeline handles under the hood.
+ *  Enables (or disables) watching the shader files of all known pipelines in the background, as an alternative
+ *  to triggering hot-reloads via vklEnablePipelineHotReloading or vklHotReloadPipelines. Only the files which the shaders
+ *  of pipelines created via vklCreateGraphicsPipeline(s)/vklCreateGraphicsPipelineAsync/vklCreateComputePipeline have been compiled from are watched,
+ *  i.e., shader files and all files #included by them. Changes are collected without blocking at the beginning of every frame
+ *  (i.e., during vklWaitForNextSwapchainImage), and once no further changes have been made for the debounce duration, only the
+ *  pipelines using the changed files are recompiled on the worker threads. If the resulting SPIR-V of all stages of a pipeline
+ *  is byte-identical to the SPIR-V of its current version (e.g., because only comments have changed), the pipeline is kept.
+ *  Watching shader files requires Linux (inotify). Again, use vklCmdBindPipeline to bind pipelines!
+ *
+ *  @param  enable                  True to start watching shader files, false to stop watching them.
+ *  @param  debounce_milliseconds   Time without further changes to wait for before reloading, so that editors which write
+ *                                  a file multiple times in a row trigger only one reload. Default: 100 milliseconds.
+ *  @return True if the watcher is in the requested state, false if watching shader files is not supported.
+ */
+bool vklEnableShaderFileWatching(bool enable, uint32_t debounce_milliseconds = 100);
+
+/*!
+ *  Replacement function for the Vulkan API's vkCmdBindPipeline function, which must be used for handles returned by
+ *  vklCreateGraphicsPipeline(s) and vklCreateGraphicsPipelineAsync. It binds the most up-to-date version of possibly
+ *  hot-reloaded pipelines. Resolving a handle does not involve any lookups, i.e., its cost does not depend on the number of pipelines.
+ *  For pipelines created with vklCreateGraphicsPipelineAsync, which are not ready yet, their fallback pipeline is bound instead.
+ *  When a pipeline with dynamic viewport and scissor is bound after one with static state (see
+ *  VklGraphicsPipelineConfig::dynamicViewportAndScissor) into the command buffer of vklStartRecordingCommands, the
+ *  viewport and scissor are set to the whole framebuffer again.
  * 
- *  Other than that, it is just a 1:1 proxy for vkCmdBindPipeline. All parameters are the same.
+ *  Other than that, it is just a 1:1 proxy for vkCmdBindPipeline. All parameters are the same, and other pipeline handles
+ *  (e.g., vklGetBasicPipeline()) are passed through unchanged.
  *  @param  commandBuffer           the command buffer that the pipeline will be bound to.
  *  @param  pipelineBindPoint       a VkPipelineBindPoint value specifying to which bind point the pipeline is bound. 
  *  @param  pipeline                the pipeline to be bound.
@@ -682,3 +1500,34 @@ void vklEnablePipelineHotReloading(GLFWwindow* glfw_window, int glfw_key, int gl
  *  More information can be found in the Vulkan specification: https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/vkCmdBindPipeline.html
  */
 void vklCmdBindPipeline(VkCommandBuffer commandBuffer, VkPipelineBindPoint pipelineBindPoint, VkPipeline pipeline);
+
+/*!
+ *  Returns the compute command buffer of the current frame, which is started on demand. Compute work cannot be recorded into
+ *  vklGetCurrentCommandBuffer(), since that one is inside the render pass. Instead, all compute commands of a frame are recorded
+ *  into this command buffer, which is submitted together with the frame's command buffer in vklEndRecordingCommands, but before it.
+ *  At its end, a barrier makes all shader writes visible to the frame's vertex input, index, indirect, and shader reads.
+ *  Use it for vkCmdPushConstants and for barriers between dependent dispatches; vklCmdDispatch records into it as well.
+ */
+VkCommandBuffer vklGetCurrentComputeCommandBuffer();
+
+/*!
+ *  Binds the most up-to-date version of the given (possibly hot-reloaded) compute pipeline and dispatches it into
+ *  vklGetCurrentComputeCommandBuffer(). The pipeline is only bound if it is not bound already.
+ *  Bind its resources with vklBindDescriptorSetToPipeline, which records compute bindings into the same command buffer.
+ *
+ *  @param  pipeline        A compute pipeline created with vklCreateComputePipeline.
+ *  @param  group_count_x   The number of local work groups to dispatch in X dimension.
+ *  @param  group_count_y   The number of local work groups to dispatch in Y dimension.
+ *  @param  group_count_z   The number of local work groups to dispatch in Z dimension.
+ */
+void vklCmdDispatch(VkPipeline pipeline, uint32_t group_count_x, uint32_t group_count_y = 1, uint32_t group_count_z = 1);
+
+/*!
+ *  Like vklCmdDispatch, but reads the work group counts from a VkDispatchIndirectCommand in the given buffer,
+ *  e.g., one which has been written by a culling shader.
+ *
+ *  @param  pipeline        A compute pipeline created with vklCreateComputePipeline.
+ *  @param  buffer          A buffer created with VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT.
+ *  @param  offset          The byte offset of the VkDispatchIndirectCommand in the buffer.
+ */
+void vklCmdDispatchIndirect(VkPipeline pipeline, VkBuffer buffer, VkDeviceSize offset = 0);
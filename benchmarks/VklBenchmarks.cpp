@@ -0,0 +1,378 @@
+/*
+ * Copyright (c) 2023 TU Wien, Institute of Visual Computing & Human-Centered Technology.
+ */
+#include "VulkanLaunchpad.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <random>
+#include <thread>
+#include "vkl_basic.vert.spv.h" // Generated by vkl_add_shaders
+#include "vkl_basic.frag.spv.h" // Generated by vkl_add_shaders
+
+// Measures the costs of Vulkan Launchpad's resource management on the first GPU that can present to a (hidden) window.
+// Built with the VKL_BUILD_BENCHMARKS CMake option. Nothing is rendered, so the results do not depend on the display.
+
+constexpr uint32_t WINDOW_WIDTH = 640;
+constexpr uint32_t WINDOW_HEIGHT = 480;
+constexpr uint32_t BUFFER_COUNT = 10000;
+constexpr VkDeviceSize BUFFER_SIZE = 256;
+constexpr uint32_t PIPELINE_RESOLUTION_COUNT = 100000;
+constexpr uint32_t COMPILED_PIPELINE_COUNT = 64;
+
+struct VklBenchmarkContext {
+	GLFWwindow* mWindow = nullptr;
+	VkInstance mInstance = VK_NULL_HANDLE;
+	VkSurfaceKHR mSurface = VK_NULL_HANDLE;
+	VkPhysicalDevice mPhysicalDevice = VK_NULL_HANDLE;
+	VkDevice mDevice = VK_NULL_HANDLE;
+	VkQueue mQueue = VK_NULL_HANDLE;
+	uint32_t mQueueFamilyIndex = 0;
+	VkSwapchainKHR mSwapchain = VK_NULL_HANDLE;
+};
+
+double millisecondsSince(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Creates everything vklInitFramework needs, and initializes the framework:
+VklBenchmarkContext initBenchmarkContext()
+{
+	VklBenchmarkContext context;
+	if (!glfwInit()) {
+		VKL_EXIT_WITH_ERROR("Failed to initialize GLFW");
+	}
+	glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
+	context.mWindow = glfwCreateWindow(WINDOW_WIDTH, WINDOW_HEIGHT, "Vulkan Launchpad Benchmarks", nullptr, nullptr);
+	if (nullptr == context.mWindow) {
+		VKL_EXIT_WITH_ERROR("Failed to create a GLFW window");
+	}
+
+	// Instance with the extensions required by GLFW and by the framework:
+	uint32_t glfwExtensionCount = 0;
+	const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+	std::vector<const char*> instanceExtensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
+	uint32_t vklExtensionCount = 0;
+	const char** vklExtensions = vklGetRequiredInstanceExtensions(&vklExtensionCount);
+	instanceExtensions.insert(instanceExtensions.end(), vklExtensions, vklExtensions + vklExtensionCount);
+
+	VkApplicationInfo applicationInfo = {};
+	applicationInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+	applicationInfo.pApplicationName = "Vulkan Launchpad Benchmarks";
+	applicationInfo.apiVersion = VK_API_VERSION_1_1;
+	VkInstanceCreateInfo instanceCreateInfo = {};
+	instanceCreateInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+	instanceCreateInfo.pApplicationInfo = &applicationInfo;
+	instanceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(instanceExtensions.size());
+	instanceCreateInfo.ppEnabledExtensionNames = instanceExtensions.data();
+	VKL_CHECK_VULKAN_ERROR(vkCreateInstance(&instanceCreateInfo, nullptr, &context.mInstance));
+	VKL_CHECK_VULKAN_ERROR(glfwCreateWindowSurface(context.mInstance, context.mWindow, nullptr, &context.mSurface));
+
+	// The framework submits to queue family 0, which must be able to render and present:
+	uint32_t physicalDeviceCount = 0;
+	vkEnumeratePhysicalDevices(context.mInstance, &physicalDeviceCount, nullptr);
+	std::vector<VkPhysicalDevice> physicalDevices(physicalDeviceCount);
+	vkEnumeratePhysicalDevices(context.mInstance, &physicalDeviceCount, physicalDevices.data());
+	for (auto physicalDevice : physicalDevices) {
+		uint32_t queueFamilyCount = 0;
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+		std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+		VkBool32 presentSupport = VK_FALSE;
+		vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, 0u, context.mSurface, &presentSupport);
+		if (queueFamilyCount > 0 && 0 != (queueFamilies[0].queueFlags & VK_QUEUE_GRAPHICS_BIT) && VK_TRUE == presentSupport) {
+			context.mPhysicalDevice = physicalDevice;
+			break;
+		}
+	}
+	if (VK_NULL_HANDLE == context.mPhysicalDevice) {
+		VKL_EXIT_WITH_ERROR("No physical device found which can render and present with queue family 0");
+	}
+	VkPhysicalDeviceProperties physicalDeviceProperties;
+	vkGetPhysicalDeviceProperties(context.mPhysicalDevice, &physicalDeviceProperties);
+	VKL_LOG("Benchmarking on " << physicalDeviceProperties.deviceName);
+
+	const float queuePriority = 1.0f;
+	VkDeviceQueueCreateInfo queueCreateInfo = {};
+	queueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+	queueCreateInfo.queueFamilyIndex = context.mQueueFamilyIndex;
+	queueCreateInfo.queueCount = 1;
+	queueCreateInfo.pQueuePriorities = &queuePriority;
+	const char* deviceExtensions[] = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
+	VkDeviceCreateInfo deviceCreateInfo = {};
+	deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+	deviceCreateInfo.queueCreateInfoCount = 1;
+	deviceCreateInfo.pQueueCreateInfos = &queueCreateInfo;
+	deviceCreateInfo.enabledExtensionCount = 1;
+	deviceCreateInfo.ppEnabledExtensionNames = deviceExtensions;
+	VKL_CHECK_VULKAN_ERROR(vkCreateDevice(context.mPhysicalDevice, &deviceCreateInfo, nullptr, &context.mDevice));
+	vkGetDeviceQueue(context.mDevice, context.mQueueFamilyIndex, 0, &context.mQueue);
+
+	// A swap chain with the surface's first format, since the framework must be initialized with one:
+	VkSurfaceCapabilitiesKHR surfaceCapabilities;
+	vkGetPhysicalDeviceSurfaceCapabilitiesKHR(context.mPhysicalDevice, context.mSurface, &surfaceCapabilities);
+	uint32_t surfaceFormatCount = 0;
+	vkGetPhysicalDeviceSurfaceFormatsKHR(context.mPhysicalDevice, context.mSurface, &surfaceFormatCount, nullptr);
+	std::vector<VkSurfaceFormatKHR> surfaceFormats(surfaceFormatCount);
+	vkGetPhysicalDeviceSurfaceFormatsKHR(context.mPhysicalDevice, context.mSurface, &surfaceFormatCount, surfaceFormats.data());
+	const VkExtent2D extent = 0xFFFFFFFFu != surfaceCapabilities.currentExtent.width ? surfaceCapabilities.currentExtent : VkExtent2D{ WINDOW_WIDTH, WINDOW_HEIGHT };
+
+	VkSwapchainCreateInfoKHR swapchainCreateInfo = {};
+	swapchainCreateInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+	swapchainCreateInfo.surface = context.mSurface;
+	swapchainCreateInfo.minImageCount = std::max(surfaceCapabilities.minImageCount, 2u);
+	if (surfaceCapabilities.maxImageCount > 0) {
+		swapchainCreateInfo.minImageCount = std::min(swapchainCreateInfo.minImageCount, surfaceCapabilities.maxImageCount);
+	}
+	swapchainCreateInfo.imageFormat = surfaceFormats[0].format;
+	swapchainCreateInfo.imageColorSpace = surfaceFormats[0].colorSpace;
+	swapchainCreateInfo.imageExtent = extent;
+	swapchainCreateInfo.imageArrayLayers = 1;
+	swapchainCreateInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+	swapchainCreateInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	swapchainCreateInfo.preTransform = surfaceCapabilities.currentTransform;
+	// Take the lowest supported composite alpha mode, which is VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR if it is supported:
+	swapchainCreateInfo.compositeAlpha = static_cast<VkCompositeAlphaFlagBitsKHR>(surfaceCapabilities.supportedCompositeAlpha & (~surfaceCapabilities.supportedCompositeAlpha + 1u));
+	swapchainCreateInfo.presentMode = VK_PRESENT_MODE_FIFO_KHR;
+	swapchainCreateInfo.clipped = VK_TRUE;
+	VKL_CHECK_VULKAN_ERROR(vkCreateSwapchainKHR(context.mDevice, &swapchainCreateInfo, nullptr, &context.mSwapchain));
+
+	uint32_t swapchainImageCount = 0;
+	vkGetSwapchainImagesKHR(context.mDevice, context.mSwapchain, &swapchainImageCount, nullptr);
+	std::vector<VkImage> swapchainImages(swapchainImageCount);
+	vkGetSwapchainImagesKHR(context.mDevice, context.mSwapchain, &swapchainImageCount, swapchainImages.data());
+
+	VklSwapchainConfig swapchainConfig = {};
+	swapchainConfig.swapchainHandle = context.mSwapchain;
+	swapchainConfig.imageExtent = extent;
+	for (auto image : swapchainImages) {
+		VklSwapchainFramebufferComposition framebufferComposition = {};
+		framebufferComposition.colorAttachmentImageDetails.imageHandle = image;
+		framebufferComposition.colorAttachmentImageDetails.imageFormat = surfaceFormats[0].format;
+		framebufferComposition.colorAttachmentImageDetails.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+		framebufferComposition.colorAttachmentImageDetails.clearValue.color = { { 0.0f, 0.0f, 0.0f, 1.0f } };
+		swapchainConfig.swapchainImages.push_back(framebufferComposition);
+	}
+	// Every run shall compile and create its pipelines, instead of loading them from a previous run's caches:
+	VklShaderCacheConfig shaderCacheConfig = {};
+	shaderCacheConfig.enabled = false;
+	vklConfigureShaderCache(shaderCacheConfig);
+	VklPipelineCacheConfig pipelineCacheConfig = {};
+	pipelineCacheConfig.enabled = false;
+	vklConfigurePipelineCache(pipelineCacheConfig);
+
+	vklInitFramework(context.mInstance, context.mSurface, context.mPhysicalDevice, context.mDevice, context.mQueue, swapchainConfig);
+	return context;
+}
+
+void destroyBenchmarkContext(VklBenchmarkContext& context)
+{
+	vklDestroyFramework();
+	vkDestroySwapchainKHR(context.mDevice, context.mSwapchain, nullptr);
+	vkDestroyDevice(context.mDevice, nullptr);
+	vkDestroySurfaceKHR(context.mInstance, context.mSurface, nullptr);
+	vkDestroyInstance(context.mInstance, nullptr);
+	glfwDestroyWindow(context.mWindow);
+	glfwTerminate();
+}
+
+// Creates and destroys buffer_count small device-local buffers with the given allocator config, and reports the timings
+// and how many allocations of device memory are backing them (the allocator's statistics, taken while all of them exist):
+void benchmarkBufferAllocations(const char* name, const VklMemoryAllocatorConfig& config, uint32_t buffer_count)
+{
+	vklConfigureMemoryAllocator(config);
+	std::vector<VkBuffer> buffers;
+	buffers.reserve(buffer_count);
+
+	const auto createStartTime = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < buffer_count; ++i) {
+		buffers.push_back(vklCreateDeviceLocalBufferWithBackingMemory(BUFFER_SIZE, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT));
+	}
+	const double createMilliseconds = millisecondsSince(createStartTime);
+	const auto statistics = vklGetMemoryAllocatorStatistics();
+
+	const auto destroyStartTime = std::chrono::steady_clock::now();
+	for (auto buffer : buffers) {
+		vklDestroyDeviceLocalBufferAndItsBackingMemory(buffer);
+	}
+	const double destroyMilliseconds = millisecondsSince(destroyStartTime);
+
+	std::cout << std::left << std::setw(28) << name << std::right
+		<< std::setw(8) << buffer_count
+		<< std::setw(13) << std::fixed << std::setprecision(2) << createMilliseconds
+		<< std::setw(14) << destroyMilliseconds
+		<< std::setw(14) << (statistics.blockCount + statistics.dedicatedAllocationCount)
+		<< std::setw(18) << (statistics.allocatedBytes / 1024) << "\n";
+}
+
+// The config of the basic pipeline (see vklGetBasicPipeline), without its shaders:
+VklGraphicsPipelineConfig createBenchmarkPipelineConfig()
+{
+	return VklGraphicsPipelineConfig{
+		nullptr, nullptr,
+		{
+			VkVertexInputBindingDescription { 0, sizeof(glm::vec3), VK_VERTEX_INPUT_RATE_VERTEX }
+		},
+		{
+			VkVertexInputAttributeDescription { 0, 0, VK_FORMAT_R32G32B32_SFLOAT, 0u }
+		},
+		VK_POLYGON_MODE_FILL,
+		VK_CULL_MODE_NONE,
+		{ /* no descriptors */ }
+	};
+}
+
+#ifndef VKL_NO_RUNTIME_SHADER_COMPILATION
+// Creates COMPILED_PIPELINE_COUNT graphics pipelines from GLSL code on the given number of worker threads, and measures how long it takes.
+// Hot-reloads compile the shaders of changed pipelines on the same worker threads. Every pipeline of every run has shaders of its own,
+// so that all of them are actually compiled:
+void benchmarkParallelShaderCompilation(uint32_t thread_count, uint32_t run)
+{
+	std::vector<std::string> shaderCode;
+	shaderCode.reserve(2 * COMPILED_PIPELINE_COUNT); // The configs point into these strings
+	std::vector<VklGraphicsPipelineConfig> configs(COMPILED_PIPELINE_COUNT, createBenchmarkPipelineConfig());
+	for (uint32_t i = 0; i < COMPILED_PIPELINE_COUNT; ++i) {
+		const auto id = std::to_string(run) + "." + std::to_string(i);
+		shaderCode.push_back(
+			"#version 450\n"
+			"layout(location = 0) in vec3 position;\n"
+			"void main() {\n"
+			"    gl_Position = vec4(position.x, -position.y, position.z, 1) * " + id + ";\n"
+			"}\n");
+		shaderCode.push_back(
+			"#version 450\n"
+			"layout(location = 0) out vec4 color;\n"
+			"void main() {\n"
+			"    color = vec4(1, 0, 0, 1) * " + id + ";\n"
+			"}\n");
+		configs[i].vertexShaderPath = shaderCode[2 * i].c_str();
+		configs[i].fragmentShaderPath = shaderCode[2 * i + 1].c_str();
+	}
+
+	vklSetWorkerThreadCount(thread_count);
+	const auto createStartTime = std::chrono::steady_clock::now();
+	const auto pipelines = vklCreateGraphicsPipelines(configs, /* loadShadersFromMemory: */ true);
+	const double createMilliseconds = millisecondsSince(createStartTime);
+	for (auto pipeline : pipelines) {
+		vklDestroyGraphicsPipeline(pipeline);
+	}
+
+	std::cout << std::right << std::setw(16) << (0 == thread_count ? std::max(1u, std::thread::hardware_concurrency()) : thread_count)
+		<< std::setw(13) << std::fixed << std::setprecision(2) << createMilliseconds
+		<< std::setw(20) << (createMilliseconds / COMPILED_PIPELINE_COUNT) << "\n";
+}
+#endif
+
+// Creates pipeline_count graphics pipelines, which only differ in the value of a specialization constant, and measures how long
+// vklCmdBindPipeline and vklGetLayoutForPipeline take per call, if they are invoked for randomly chosen ones of them:
+void benchmarkPipelineResolution(VkCommandBuffer command_buffer, uint32_t pipeline_count)
+{
+	auto config = createBenchmarkPipelineConfig();
+	config.vertexShaderSpirv = vkl_basic_vert_spv;
+	config.vertexShaderSpirvSizeInBytes = sizeof(vkl_basic_vert_spv);
+	config.fragmentShaderSpirv = vkl_basic_frag_spv;
+	config.fragmentShaderSpirvSizeInBytes = sizeof(vkl_basic_frag_spv);
+	std::vector<VklGraphicsPipelineConfig> configs(pipeline_count, config);
+	for (uint32_t i = 0; i < pipeline_count; ++i) {
+		// The shader does not declare constant_id 0, so this only makes the configs (and thus the pipelines) distinct:
+		configs[i].fragmentShaderSpecializationConstants = { VklSpecializationConstant{ 0u, i } };
+	}
+	const auto createStartTime = std::chrono::steady_clock::now();
+	const auto pipelines = vklCreateGraphicsPipelines(configs);
+	const double createMilliseconds = millisecondsSince(createStartTime);
+
+	// A random order (with a fixed seed, for comparable runs), so that the lookups of many pipelines are not served from the CPU cache:
+	std::mt19937 random{ 42u };
+	std::uniform_int_distribution<size_t> distribution{ 0, pipelines.size() - 1 };
+	std::vector<VkPipeline> sequence(PIPELINE_RESOLUTION_COUNT);
+	for (auto& pipeline : sequence) {
+		pipeline = pipelines[distribution(random)];
+	}
+
+	VkCommandBufferBeginInfo beginInfo = {};
+	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	vkBeginCommandBuffer(command_buffer, &beginInfo);
+	const auto bindStartTime = std::chrono::steady_clock::now();
+	for (auto pipeline : sequence) {
+		vklCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+	}
+	const double bindMilliseconds = millisecondsSince(bindStartTime);
+	vkEndCommandBuffer(command_buffer);
+	vkResetCommandBuffer(command_buffer, 0);
+
+	const auto layoutStartTime = std::chrono::steady_clock::now();
+	VkPipelineLayout volatile layout = VK_NULL_HANDLE;
+	for (auto pipeline : sequence) {
+		layout = vklGetLayoutForPipeline(pipeline);
+	}
+	const double layoutMilliseconds = millisecondsSince(layoutStartTime);
+
+	for (auto pipeline : pipelines) {
+		vklDestroyGraphicsPipeline(pipeline);
+	}
+
+	std::cout << std::right << std::setw(10) << pipeline_count
+		<< std::setw(13) << std::fixed << std::setprecision(2) << createMilliseconds
+		<< std::setw(30) << (bindMilliseconds * 1e6 / PIPELINE_RESOLUTION_COUNT)
+		<< std::setw(35) << (layoutMilliseconds * 1e6 / PIPELINE_RESOLUTION_COUNT) << "\n";
+}
+
+int main()
+{
+	auto context = initBenchmarkContext();
+
+	// Dedicated allocations are limited by maxMemoryAllocationCount, which is as low as 4096 on some platforms:
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(context.mPhysicalDevice, &properties);
+	const uint32_t dedicatedBufferCount = std::min(BUFFER_COUNT, properties.limits.maxMemoryAllocationCount - 64u);
+
+	std::cout << "\nCreating and destroying " << BUFFER_SIZE << " byte device-local buffers:\n"
+		<< std::left << std::setw(28) << "Allocator" << std::right
+		<< std::setw(8) << "Buffers" << std::setw(13) << "Create [ms]" << std::setw(14) << "Destroy [ms]"
+		<< std::setw(14) << "Allocations" << std::setw(18) << "Allocated [KiB]" << "\n";
+	VklMemoryAllocatorConfig dedicatedConfig = {};
+	dedicatedConfig.enabled = false;
+	benchmarkBufferAllocations("vkAllocateMemory per buffer", dedicatedConfig, dedicatedBufferCount);
+	benchmarkBufferAllocations("Built-in, best fit", VklMemoryAllocatorConfig{}, BUFFER_COUNT);
+	VklMemoryAllocatorConfig linearConfig = {};
+	linearConfig.linear = true;
+	benchmarkBufferAllocations("Built-in, linear", linearConfig, BUFFER_COUNT);
+	vklConfigureMemoryAllocator(VklMemoryAllocatorConfig{});
+
+#ifndef VKL_NO_RUNTIME_SHADER_COMPILATION
+	std::cout << "\nCompiling the GLSL shaders of " << COMPILED_PIPELINE_COUNT << " pipelines and creating them:\n"
+		<< std::right << std::setw(16) << "Worker threads" << std::setw(13) << "Create [ms]" << std::setw(20) << "Per pipeline [ms]" << "\n";
+	benchmarkParallelShaderCompilation(1u, 0u);
+	benchmarkParallelShaderCompilation(0u, 1u);
+#endif
+
+	// vklCmdBindPipeline is recorded into a command buffer of our own, which is never submitted:
+	VkCommandPoolCreateInfo commandPoolCreateInfo = {};
+	commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+	commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+	commandPoolCreateInfo.queueFamilyIndex = context.mQueueFamilyIndex;
+	VkCommandPool commandPool = VK_NULL_HANDLE;
+	VKL_CHECK_VULKAN_ERROR(vkCreateCommandPool(context.mDevice, &commandPoolCreateInfo, nullptr, &commandPool));
+	VkCommandBufferAllocateInfo commandBufferAllocateInfo = {};
+	commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+	commandBufferAllocateInfo.commandPool = commandPool;
+	commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	commandBufferAllocateInfo.commandBufferCount = 1;
+	VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+	VKL_CHECK_VULKAN_ERROR(vkAllocateCommandBuffers(context.mDevice, &commandBufferAllocateInfo, &commandBuffer));
+
+	std::cout << "\nResolving pipeline handles (" << PIPELINE_RESOLUTION_COUNT << " calls each, in random order):\n"
+		<< std::right << std::setw(10) << "Pipelines" << std::setw(13) << "Create [ms]"
+		<< std::setw(30) << "vklCmdBindPipeline [ns/call]" << std::setw(35) << "vklGetLayoutForPipeline [ns/call]" << "\n";
+	for (uint32_t pipelineCount : { 10u, 1000u, 10000u }) {
+		benchmarkPipelineResolution(commandBuffer, pipelineCount);
+	}
+	vkDestroyCommandPool(context.mDevice, commandPool, nullptr);
+
+	destroyBenchmarkContext(context);
+	return 0;
+}